@@ -0,0 +1,201 @@
+// Multi-day driver: runs any subset of the days' solutions in one process.
+//
+// Build from the repository root by linking every day's solution without its
+// main:
+//
+//     g++ -std=c++17 -O2 -pthread -DAOC_NO_MAIN -o aoc/aoc aoc/aoc.cpp day_*/*.cpp
+//
+// Usage:
+//
+//     aoc/aoc [--threads N] [--root DIR] [--cache DIR] [--time] [day_N ...]
+//
+// Solves the given days (default: all) reading input from DIR/day_N/input.txt
+// (default DIR: .) and writes each day's answers to stdout, in the order given,
+// after a "==> day_N <==" header. Days run one after another unless N (default:
+// 1) is more than 1, in which case they run concurrently on N worker threads.
+//
+// --time also writes the wall time of each day's parse, part 1 and part 2
+// phases to stderr.
+//
+// --cache DIR reuses the answers stored under DIR for inputs solved before and
+// stores new ones there; DIR may be shared between concurrent runs. The number
+// of cache hits and misses is written to stderr.
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/cache.h"
+#include "../common/days.h"
+#include "../common/input.h"
+#include "../common/thread_pool.h"
+
+using std::string;
+using std::string_view;
+using std::vector;
+
+using Clock = std::chrono::steady_clock;
+
+const char* const PHASES[] = {"parse", "part_1", "part_2"};
+
+// Result of running one day: its answers, whether it succeeded and the time
+// taken by each phase that ran.
+struct Result {
+    string output;
+    bool ok = false;
+    bool cached = false;   // the answers came from the cache, no phase ran
+    long long times_ns[3] = {};
+};
+
+// Returns the result of solving day over its input under root, using the
+// answers in cache, if given, and storing those it computes there.
+Result run_day(const Day& day, const string& root, ResultCache* cache)
+{
+    Result result;
+    std::ostringstream os;
+
+    // Returns f(), recording its wall time against phase.
+    auto timed = [&](int phase, auto f) {
+        auto start = Clock::now();
+        bool ok = f();
+        auto end = Clock::now();
+        result.times_ns[phase] = std::chrono::nanoseconds{end - start}.count();
+        return ok;
+    };
+
+    try {
+        std::optional<Input> input;
+        string_view data;
+        if (day.has_input) {
+            input.emplace(root + "/" + day.name + "/input.txt");
+            data = input->data();
+        }
+
+        auto solver = day.make_solver();
+        std::optional<CacheKey> key;
+        if (cache != nullptr) {
+            key = CacheKey{day.name, hash_bytes(data), solver->version()};
+            auto answer_1 = cache->get(*key, 1);
+            auto answer_2 = answer_1 ? cache->get(*key, 2) : std::nullopt;
+            if (answer_1 && answer_2) {
+                result.output = *answer_1 + *answer_2;
+                result.ok = true;
+                result.cached = true;
+                return result;
+            }
+        }
+
+        timed(0, [&] { solver->parse(data); return true; });
+        result.ok = timed(1, [&] { return solver->part_1(os); });
+        auto part_2_start = os.tellp();
+        result.ok = result.ok && timed(2, [&] { return solver->part_2(os); });
+
+        if (key && result.ok) {
+            auto output = os.str();
+            cache->put(*key, 1, output.substr(0, part_2_start));
+            cache->put(*key, 2, output.substr(part_2_start));
+        }
+    } catch (const std::exception& e) {
+        os << "error: " << e.what() << '\n';
+    }
+
+    result.output = os.str();
+    return result;
+}
+
+// Writes the answers in result to os and its phase times to log if given,
+// returns false if the day failed.
+bool report(const string& day, const Result& result, std::ostream& os, std::ostream* log)
+{
+    os << "==> " << day << " <==\n" << result.output;
+    os.flush();
+    if (log != nullptr) {
+        *log << day << ":";
+        if (result.cached) {
+            *log << " cached" << std::endl;
+            return result.ok;
+        }
+        for (int phase = 0; phase < 3; phase++) {
+            *log << ' ' << PHASES[phase] << ' '
+                 << std::fixed << std::setprecision(3) << result.times_ns[phase] / 1e6 << " ms";
+        }
+        *log << std::endl;
+    }
+    return result.ok;
+}
+
+int main(int argc, char* argv[])
+{
+    int n_threads = 1;
+    string root = ".";
+    bool time = false;
+    std::unique_ptr<ResultCache> cache;
+    vector<string> names;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            n_threads = std::atoi(argv[++i]);
+        } else if (arg == "--root" && i + 1 < argc) {
+            root = argv[++i];
+        } else if (arg == "--cache" && i + 1 < argc) {
+            cache = std::make_unique<ResultCache>(argv[++i]);
+        } else if (arg == "--time") {
+            time = true;
+        } else {
+            names.push_back(arg);
+        }
+    }
+    if (names.empty()) {
+        for (const auto& day : DAYS) {
+            names.push_back(day.name);
+        }
+    }
+
+    vector<const Day*> days;
+    try {
+        for (const auto& name : names) {
+            days.push_back(&find_day(name));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::ostream* log = time ? &std::cerr : nullptr;
+    int n_failed = 0;
+    auto start = Clock::now();
+
+    if (n_threads <= 1) {
+        for (const auto* day : days) {
+            n_failed += !report(day->name, run_day(*day, root, cache.get()), std::cout, log);
+        }
+    } else {
+        vector<Result> results(days.size());
+        ThreadPool pool(n_threads);
+        pool.run(days.size(), [&](size_t task, size_t /* worker */) {
+            results[task] = run_day(*days[task], root, cache.get());
+        });
+        for (size_t i = 0; i < days.size(); i++) {
+            n_failed += !report(days[i]->name, results[i], std::cout, log);
+        }
+    }
+
+    if (log != nullptr) {
+        auto total = std::chrono::nanoseconds{Clock::now() - start}.count();
+        *log << "total: " << std::fixed << std::setprecision(3) << total / 1e6 << " ms"
+             << std::endl;
+    }
+    if (cache) {
+        report_cache(*cache, std::cerr);
+    }
+
+    return n_failed == 0 ? 0 : 1;
+}
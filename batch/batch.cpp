@@ -0,0 +1,176 @@
+// Batch runner: solves one day over many input files in a single process.
+//
+// Build from the repository root by linking every day's solution without its
+// main:
+//
+//     g++ -std=c++17 -O2 -pthread -DAOC_NO_MAIN -o batch/batch batch/batch.cpp day_*/*.cpp
+//
+// Usage:
+//
+//     batch/batch day_N [--threads N] [--cache DIR] [PATH ...]
+//
+// Solves day_N for each PATH (default: one path per line of stdin) on N worker
+// threads (default: one per hardware thread). The answers for each input are
+// written to stdout in input order, after a "==> PATH <==" header.
+//
+// --cache DIR reuses the answers stored under DIR for inputs with the same
+// contents as ones solved before and stores new ones there; DIR may be shared
+// between concurrent runs. The number of cache hits and misses is written to
+// stderr.
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../common/cache.h"
+#include "../common/days.h"
+#include "../common/input.h"
+#include "../common/thread_pool.h"
+
+using std::string;
+using std::vector;
+
+// Stream buffer that appends to a string whose capacity is kept across
+// clear() calls, so a worker's output buffer is only grown, never reallocated
+// from scratch for each input.
+class ScratchBuf : public std::streambuf {
+public:
+    void clear() { buffer.clear(); }
+
+    const string& str() const { return buffer; }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            buffer.push_back(traits_type::to_char_type(ch));
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        buffer.append(s, n);
+        return n;
+    }
+
+private:
+    string buffer;
+};
+
+// Result of solving one input: the text to print and whether it succeeded.
+struct Result {
+    string output;
+    bool ok = false;
+    bool done = false;
+};
+
+// Writes results to os in input order as soon as each becomes available.
+class OrderedWriter {
+public:
+    OrderedWriter(const vector<string>& paths, std::ostream& os)
+        : paths{paths}, results(paths.size()), os{os} { }
+
+    // Records the result for input i and writes any results now in order.
+    void put(size_t i, Result result)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        results[i] = std::move(result);
+        results[i].done = true;
+        for (; next < results.size() && results[next].done; next++) {
+            os << "==> " << paths[next] << " <==\n" << results[next].output;
+            n_failed += !results[next].ok;
+            results[next].output = string{};
+        }
+        os.flush();
+    }
+
+    int failures() const { return n_failed; }
+
+private:
+    const vector<string>& paths;
+    vector<Result> results;
+    std::ostream& os;
+    std::mutex mutex;
+    size_t next = 0;
+    int n_failed = 0;
+};
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " day_N [--threads N] [--cache DIR] [PATH ...]"
+                  << std::endl;
+        return 1;
+    }
+
+    const Day* day;
+    try {
+        day = &find_day(argv[1]);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    int n_threads = std::thread::hardware_concurrency();
+    std::unique_ptr<ResultCache> cache;
+    vector<string> paths;
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            n_threads = std::atoi(argv[++i]);
+        } else if (arg == "--cache" && i + 1 < argc) {
+            cache = std::make_unique<ResultCache>(argv[++i]);
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.empty()) {
+        string path;
+        while (std::getline(std::cin, path)) {
+            if (!path.empty()) {
+                paths.push_back(path);
+            }
+        }
+    }
+
+    ThreadPool pool(std::max(n_threads, 1));
+    OrderedWriter writer{paths, std::cout};
+
+    // one output buffer per worker, reused across inputs
+    vector<ScratchBuf> scratch(pool.size());
+
+    pool.run(paths.size(), [&](size_t task, size_t worker) {
+        auto& buf = scratch[worker];
+        buf.clear();
+        std::ostream os{&buf};
+
+        Result result;
+        try {
+            const Input input{paths[task]};
+            if (cache) {
+                auto solver = day->make_solver();
+                result.ok = solve_cached(*cache, day->name, *solver, input.data(), os).ok;
+            } else {
+                result.ok = day->solve(input.data(), os);
+            }
+        } catch (const std::exception& e) {
+            os << "error: " << e.what() << '\n';
+        }
+        result.output = buf.str();
+        writer.put(task, std::move(result));
+    });
+
+    if (cache) {
+        report_cache(*cache, std::cerr);
+    }
+
+    return writer.failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,217 @@
+// Benchmark suite: times the parse, part 1 and part 2 phases of each day.
+//
+// Build from the repository root by linking every day's solution without its
+// main:
+//
+//     g++ -std=c++17 -O2 -DAOC_NO_MAIN -o bench/bench bench/bench.cpp day_*/*.cpp
+//
+// Adding -DAOC_COUNT_ALLOCS replaces the global operator new and delete with
+// counting versions and adds the number of allocations, bytes allocated and
+// peak live bytes of each phase to the report.
+//
+// Usage:
+//
+//     bench/bench [--reps N] [--root DIR] [--perf] [day_N ...]
+//     bench/bench --baseline FILE [--threshold PCT] [--alpha P] [--reps N] [--root DIR] [day_N ...]
+//
+// Runs the given days (default: all) N times each (default: 5) reading input
+// from DIR/day_N/input.txt (default DIR: .) and writes the min, median and p99
+// time of each phase, and the time of every run, as JSON to stdout.
+//
+// --perf adds the cycles, instructions, L1d, LLC and dTLB read misses and
+// branch misses of each phase's last run, read from the CPU's performance
+// counters. Counters the system does not permit are reported on stderr and
+// left out.
+//
+// --baseline FILE instead compares the phases against a report written
+// earlier, running the days in it (default: all) N times (default: as many as
+// the baseline). A phase regressed if its median is more than PCT percent
+// (default: 5) above the baseline's and a one-sided Mann-Whitney U test over
+// the runs' times finds it slower with p below P (default: 0.05), so a single
+// noisy run cannot fail it. Writes one line per phase to stdout and exits with
+// status 1 if any phase regressed. Use at least 5 runs on each side: fewer
+// cannot reach p < 0.05.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/bench.h"
+#include "../common/count_allocs.h"
+#include "../common/days.h"
+#include "../common/json.h"
+#include "../common/stats.h"
+
+using std::string;
+using std::vector;
+
+// Returns the report in the file at path.
+Json read_report(const string& path)
+{
+    std::ifstream file{path};
+    if (!file) {
+        throw std::invalid_argument{"unable to open " + path};
+    }
+    return Json::parse(string{std::istreambuf_iterator<char>{file}, {}});
+}
+
+// Compares each phase timed by bench with the same phase in baseline, writes
+// the verdict for each to os and returns the number that regressed.
+int compare(const Bench& bench, const Json& baseline, double threshold, double alpha, std::ostream& os)
+{
+    // times of every run of each (day, phase) in the baseline
+    std::map<std::pair<string, string>, vector<long long>> baseline_times;
+    for (const auto& entry : baseline.at("benchmarks").array) {
+        const auto* times = entry.find("times_ns");
+        if (times == nullptr) {
+            throw std::invalid_argument{"baseline has no times_ns, rewrite it with this version"};
+        }
+        auto& samples = baseline_times[{entry.at("day").string, entry.at("phase").string}];
+        for (const auto& time : times->array) {
+            samples.push_back(static_cast<long long>(time.number));
+        }
+        std::sort(samples.begin(), samples.end());
+    }
+
+    int n_regressed = 0;
+    for (const auto& ps : bench.results()) {
+        os << ps.day << " " << ps.phase << ": ";
+        auto found = baseline_times.find({ps.day, ps.phase});
+        if (found == baseline_times.end() || found->second.empty()) {
+            os << "median " << ps.median() << " ns, not in baseline" << std::endl;
+            continue;
+        }
+
+        PhaseStats base{ps.day, ps.phase, found->second, {}, {}};
+        double change = static_cast<double>(ps.median()) / std::max(base.median(), 1LL) - 1;
+        double p_slower = mann_whitney_greater(base.times_ns, ps.times_ns);
+        double p_faster = mann_whitney_greater(ps.times_ns, base.times_ns);
+
+        const char* verdict = "ok";
+        if (change > threshold && p_slower < alpha) {
+            verdict = "REGRESSED";
+            n_regressed++;
+        } else if (change < -threshold && p_faster < alpha) {
+            verdict = "improved";
+        }
+
+        char line[128];
+        std::snprintf(
+            line, sizeof(line), "median %lld -> %lld ns (%+.1f%%), p = %.3g, %s",
+            base.median(), ps.median(), change * 100, change > 0 ? p_slower : p_faster, verdict
+        );
+        os << line << std::endl;
+
+        if (mann_whitney_min_p(base.times_ns.size(), ps.times_ns.size()) >= alpha) {
+            std::cerr << ps.day << " " << ps.phase
+                      << ": too few runs for a significant result" << std::endl;
+        }
+    }
+    return n_regressed;
+}
+
+int main(int argc, char* argv[])
+{
+    int reps = 0;
+    string root = ".";
+    bool perf = false;
+    string baseline_path;
+    double threshold = 5;
+    double alpha = 0.05;
+    vector<string> days;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--reps" && i + 1 < argc) {
+            reps = std::atoi(argv[++i]);
+        } else if (arg == "--root" && i + 1 < argc) {
+            root = argv[++i];
+        } else if (arg == "--perf") {
+            perf = true;
+        } else if (arg == "--baseline" && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (arg == "--threshold" && i + 1 < argc) {
+            threshold = std::atof(argv[++i]);
+        } else if (arg == "--alpha" && i + 1 < argc) {
+            alpha = std::atof(argv[++i]);
+        } else {
+            days.push_back(arg);
+        }
+    }
+
+    Json baseline;
+    if (!baseline_path.empty()) {
+        try {
+            baseline = read_report(baseline_path);
+            if (reps == 0) {
+                reps = static_cast<int>(baseline.at("repetitions").number);
+            }
+            if (days.empty()) {
+                for (const auto& entry : baseline.at("benchmarks").array) {
+                    const auto& day = entry.at("day").string;
+                    if (std::find(days.begin(), days.end(), day) == days.end()) {
+                        days.push_back(day);
+                    }
+                }
+            }
+        } catch (const std::exception& e) {
+            std::cerr << baseline_path << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (reps == 0) {
+        reps = 5;
+    }
+    if (reps < 1) {
+        std::cerr << "--reps must be at least 1" << std::endl;
+        return 1;
+    }
+    if (days.empty()) {
+        for (const auto& day : DAYS) {
+            days.push_back(day.name);
+        }
+    }
+
+    Bench bench{reps};
+    if (perf) {
+        const auto& unavailable = bench.enable_perf();
+        if (!unavailable.empty()) {
+            std::cerr << "perf counters unavailable:";
+            for (const auto& name : unavailable) {
+                std::cerr << ' ' << name;
+            }
+            std::cerr << std::endl;
+        }
+    }
+
+    try {
+        for (const auto& day : days) {
+            const auto& entry = find_day(day);
+            bench.set_day(day);
+            entry.benchmark(bench, root + "/" + day + "/input.txt");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    if (baseline_path.empty()) {
+        std::cout << bench;
+        return 0;
+    }
+
+    try {
+        return compare(bench, baseline, threshold / 100, alpha, std::cout) == 0 ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << baseline_path << ": " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Allocation counters, updated by the replacement operator new and delete in
+// count_allocs.h when a program is built with -DAOC_COUNT_ALLOCS.
+#ifdef AOC_COUNT_ALLOCS
+constexpr bool COUNT_ALLOCS = true;
+#else
+constexpr bool COUNT_ALLOCS = false;
+#endif
+
+namespace alloc_counters {
+
+inline std::atomic<long long> count{0};    // allocations made
+inline std::atomic<long long> bytes{0};    // bytes requested by allocations
+inline std::atomic<long long> live{0};     // bytes currently allocated
+inline std::atomic<long long> peak{0};     // high-water mark of live
+
+// Records an allocation of size bytes.
+inline void on_allocate(std::size_t size)
+{
+    auto n = static_cast<long long>(size);
+    count.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(n, std::memory_order_relaxed);
+    auto now = live.fetch_add(n, std::memory_order_relaxed) + n;
+    auto high = peak.load(std::memory_order_relaxed);
+    while (now > high && !peak.compare_exchange_weak(high, now, std::memory_order_relaxed));
+}
+
+// Records the release of an allocation of size bytes.
+inline void on_deallocate(std::size_t size)
+{
+    live.fetch_sub(static_cast<long long>(size), std::memory_order_relaxed);
+}
+
+} // namespace alloc_counters
+
+// Allocations made between construction and a call to stop().
+struct AllocStats {
+    long long count = 0;
+    long long bytes = 0;
+    long long peak_bytes = 0;   // peak live bytes above those live at the start
+
+    // Starts counting, resetting the high-water mark to the current usage.
+    static AllocStats start()
+    {
+        AllocStats stats;
+        stats.count = alloc_counters::count.load();
+        stats.bytes = alloc_counters::bytes.load();
+        stats.peak_bytes = alloc_counters::live.load();
+        alloc_counters::peak.store(stats.peak_bytes);
+        return stats;
+    }
+
+    // Returns the allocations made since start() returned this.
+    AllocStats stop() const
+    {
+        return {
+            alloc_counters::count.load() - count,
+            alloc_counters::bytes.load() - bytes,
+            alloc_counters::peak.load() - peak_bytes,
+        };
+    }
+};
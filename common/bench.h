@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "alloc.h"
+#include "perf.h"
+
+// Prevents the compiler from optimizing away the computation of value.
+template <typename T>
+inline void do_not_optimize(const T& value)
+{
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+// Timings of one phase (parse, part 1, part 2) of a day's solution.
+struct PhaseStats {
+    std::string day;
+    std::string phase;
+    std::vector<long long> times_ns;   // one entry per repetition, sorted
+    AllocStats allocs;                 // of the last repetition, if counted
+    std::vector<PerfValue> counters;   // of the last repetition, if enabled
+
+    long long min() const { return times_ns.front(); }
+
+    long long median() const
+    {
+        auto n = times_ns.size();
+        if (n % 2 == 1) {
+            return times_ns[n / 2];
+        }
+        return (times_ns[n / 2 - 1] + times_ns[n / 2]) / 2;
+    }
+
+    // Nearest-rank 99th percentile.
+    long long p99() const
+    {
+        auto rank = static_cast<size_t>(std::ceil(0.99 * times_ns.size()));
+        return times_ns[std::max<size_t>(rank, 1) - 1];
+    }
+};
+
+// Collects per-phase timings of each day's solution over repeated runs.
+class Bench {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit Bench(int repetitions = 1) : repetitions{std::max(repetitions, 1)} { }
+
+    int get_repetitions() const { return repetitions; }
+
+    // Records hardware counters for the last repetition of each phase and
+    // returns the names of those that are not available.
+    const std::vector<std::string>& enable_perf()
+    {
+        perf = std::make_unique<PerfCounters>();
+        return perf->unavailable();
+    }
+
+    // Sets the day that subsequent phases are recorded against.
+    void set_day(const std::string& name) { day = name; }
+
+    // Runs f repetitions times, records the time taken by each run against
+    // the phase name and returns the result of the last run.
+    //
+    // When built with -DAOC_COUNT_ALLOCS the allocations made by the last run
+    // are recorded too, as are its hardware counters if enabled.
+    template <typename F>
+    auto phase(const std::string& name, F f)
+    {
+        PhaseStats ps{day, name, {}, {}, {}};
+        for (int i = 1; i < repetitions; i++) {
+            auto start = Clock::now();
+            auto result = f();
+            auto end = Clock::now();
+            do_not_optimize(result);
+            ps.times_ns.push_back(elapsed_ns(start, end));
+        }
+        auto allocs = COUNT_ALLOCS ? AllocStats::start() : AllocStats{};
+        if (perf) {
+            perf->start();
+        }
+        auto start = Clock::now();
+        auto result = f();
+        auto end = Clock::now();
+        if (perf) {
+            ps.counters = perf->stop();
+        }
+        if (COUNT_ALLOCS) {
+            ps.allocs = allocs.stop();
+        }
+        do_not_optimize(result);
+        ps.times_ns.push_back(elapsed_ns(start, end));
+
+        std::sort(ps.times_ns.begin(), ps.times_ns.end());
+        stats.push_back(ps);
+
+        return result;
+    }
+
+    const std::vector<PhaseStats>& results() const { return stats; }
+
+private:
+    int repetitions;
+    std::string day;
+    std::vector<PhaseStats> stats;
+    std::unique_ptr<PerfCounters> perf;
+
+    static long long elapsed_ns(Clock::time_point start, Clock::time_point end)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            end - start
+        ).count();
+    }
+};
+
+// Writes the results collected by bench as a JSON document.
+inline std::ostream& operator<<(std::ostream& os, const Bench& bench)
+{
+    os << "{\n";
+    os << "  \"repetitions\": " << bench.get_repetitions() << ",\n";
+    os << "  \"benchmarks\": [";
+    const auto& stats = bench.results();
+    for (size_t i = 0; i < stats.size(); i++) {
+        const auto& ps = stats[i];
+        os << (i == 0 ? "\n" : ",\n");
+        os << "    {\"day\": \"" << ps.day << "\""
+           << ", \"phase\": \"" << ps.phase << "\""
+           << ", \"min_ns\": " << ps.min()
+           << ", \"median_ns\": " << ps.median()
+           << ", \"p99_ns\": " << ps.p99()
+           << ", \"times_ns\": [";
+        for (size_t j = 0; j < ps.times_ns.size(); j++) {
+            os << (j == 0 ? "" : ", ") << ps.times_ns[j];
+        }
+        os << "]";
+        if (COUNT_ALLOCS) {
+            os << ", \"allocs\": " << ps.allocs.count
+               << ", \"alloc_bytes\": " << ps.allocs.bytes
+               << ", \"peak_bytes\": " << ps.allocs.peak_bytes;
+        }
+        if (!ps.counters.empty()) {
+            os << ", \"perf\": {";
+            for (size_t j = 0; j < ps.counters.size(); j++) {
+                os << (j == 0 ? "" : ", ")
+                   << "\"" << ps.counters[j].name << "\": " << ps.counters[j].value;
+            }
+            os << "}";
+        }
+        os << "}";
+    }
+    os << "\n  ]\n";
+    os << "}\n";
+    return os;
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <unistd.h>
+
+#include "solver.h"
+
+// Returns a 64-bit FNV-1a hash of data.
+inline std::uint64_t hash_bytes(std::string_view data)
+{
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for (unsigned char c : data) {
+        hash = (hash ^ c) * 0x100000001b3;
+    }
+    return hash;
+}
+
+// Identifies the answers of one version of a day's solution to one input.
+struct CacheKey {
+    std::string day;
+    std::uint64_t input_hash;
+    int version;
+};
+
+// A persistent on-disk store of answers, one file per (day, part, input hash,
+// solver version) under a root directory.
+//
+// Entries are written to a temporary file and renamed into place, so any
+// number of threads and processes may share a directory: readers see either
+// no entry or a complete one, and concurrent writers of the same entry store
+// the same answer. The cache is best effort, an entry that cannot be written
+// is counted and otherwise ignored.
+class ResultCache {
+public:
+    explicit ResultCache(std::string root) : root{std::move(root)} { }
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    // Returns the cached answer to part of key if there is one.
+    std::optional<std::string> get(const CacheKey& key, int part)
+    {
+        std::ifstream file{path(key, part), std::ios::binary};
+        if (!file) {
+            n_misses++;
+            return std::nullopt;
+        }
+        n_hits++;
+        return std::string{std::istreambuf_iterator<char>{file}, {}};
+    }
+
+    // Stores answer as the answer to part of key.
+    void put(const CacheKey& key, int part, std::string_view answer)
+    {
+        namespace fs = std::filesystem;
+
+        auto target = path(key, part);
+        std::error_code error;
+        fs::create_directories(fs::path{target}.parent_path(), error);
+
+        // unique per process and per call within it
+        auto temp = target + ".tmp." + std::to_string(::getpid()) + "."
+            + std::to_string(n_temp_files++);
+        {
+            std::ofstream file{temp, std::ios::binary};
+            file.write(answer.data(), answer.size());
+            if (!file.flush()) {
+                n_write_errors++;
+                std::remove(temp.c_str());
+                return;
+            }
+        }
+        if (std::rename(temp.c_str(), target.c_str()) != 0) {
+            n_write_errors++;
+            std::remove(temp.c_str());
+            return;
+        }
+        n_stores++;
+    }
+
+    long long hits() const { return n_hits; }
+    long long misses() const { return n_misses; }
+    long long stores() const { return n_stores; }
+    long long write_errors() const { return n_write_errors; }
+
+private:
+    // Returns the file holding the answer to part of key.
+    std::string path(const CacheKey& key, int part) const
+    {
+        std::ostringstream name;
+        name << root << '/' << key.day << '/'
+             << std::hex << std::setw(16) << std::setfill('0') << key.input_hash
+             << std::dec << "-v" << key.version << ".part_" << part;
+        return name.str();
+    }
+
+    std::string root;
+    std::atomic<long long> n_hits{0};
+    std::atomic<long long> n_misses{0};
+    std::atomic<long long> n_stores{0};
+    std::atomic<long long> n_write_errors{0};
+    std::atomic<long long> n_temp_files{0};
+};
+
+// Writes the hit, miss and store counts of cache to os.
+inline void report_cache(const ResultCache& cache, std::ostream& os)
+{
+    os << "cache: " << cache.hits() << " hits, " << cache.misses() << " misses, "
+       << cache.stores() << " stored";
+    if (cache.write_errors() > 0) {
+        os << ", " << cache.write_errors() << " write errors";
+    }
+    os << std::endl;
+}
+
+// Outcome of solve_cached().
+struct CachedSolve {
+    bool ok = false;    // every answer was found
+    bool hit = false;   // the answers came from the cache
+};
+
+// Writes the answers of day's solver for input to os like solver.solve(), but
+// takes them from cache when both parts are there and stores those it has to
+// compute.
+//
+// Later parts may depend on state left by earlier ones, so a partial hit
+// still runs every phase.
+inline CachedSolve solve_cached(
+    ResultCache& cache, const std::string& day, Solver& solver, std::string_view input,
+    std::ostream& os)
+{
+    CacheKey key{day, hash_bytes(input), solver.version()};
+
+    auto answer_1 = cache.get(key, 1);
+    auto answer_2 = answer_1 ? cache.get(key, 2) : std::nullopt;
+    if (answer_1 && answer_2) {
+        os << *answer_1 << *answer_2;
+        return {true, true};
+    }
+
+    solver.parse(input);
+    std::ostringstream part_1;
+    std::ostringstream part_2;
+    bool ok = solver.part_1(part_1) && solver.part_2(part_2);
+    os << part_1.str() << part_2.str();
+
+    // failures are not cached, they are cheap to rediscover and may be fixed
+    if (ok) {
+        cache.put(key, 1, part_1.str());
+        cache.put(key, 2, part_2.str());
+    }
+    return {ok, false};
+}
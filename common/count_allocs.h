@@ -0,0 +1,129 @@
+#pragma once
+
+// Replacement global operator new and delete that update alloc_counters.
+//
+// Replacement allocation functions may only be defined once per program, so
+// include this header from the one translation unit holding main() and build
+// with -DAOC_COUNT_ALLOCS; without it this header defines nothing.
+#ifdef AOC_COUNT_ALLOCS
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "alloc.h"
+
+namespace alloc_counters {
+
+// Each block is preceded by a header holding its requested size, padded to
+// keep the returned pointer aligned to align.
+inline void* allocate(std::size_t size, std::size_t align)
+{
+    std::size_t header = align < alignof(std::max_align_t) ? alignof(std::max_align_t) : align;
+    void* base = align <= alignof(std::max_align_t)
+        ? std::malloc(header + size)
+        : std::aligned_alloc(align, (header + size + align - 1) / align * align);
+    if (base == nullptr) {
+        return nullptr;
+    }
+    auto block = static_cast<char*>(base) + header;
+    reinterpret_cast<std::size_t*>(block)[-1] = size;
+    on_allocate(size);
+    return block;
+}
+
+inline void deallocate(void* ptr, std::size_t align)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    std::size_t header = align < alignof(std::max_align_t) ? alignof(std::max_align_t) : align;
+    auto block = static_cast<char*>(ptr);
+    on_deallocate(reinterpret_cast<std::size_t*>(block)[-1]);
+    std::free(block - header);
+}
+
+inline void* allocate_or_throw(std::size_t size, std::size_t align)
+{
+    void* ptr = allocate(size, align);
+    if (ptr == nullptr) {
+        throw std::bad_alloc{};
+    }
+    return ptr;
+}
+
+} // namespace alloc_counters
+
+constexpr std::size_t DEFAULT_ALIGN = alignof(std::max_align_t);
+
+void* operator new(std::size_t size)
+{
+    return alloc_counters::allocate_or_throw(size, DEFAULT_ALIGN);
+}
+
+void* operator new[](std::size_t size)
+{
+    return alloc_counters::allocate_or_throw(size, DEFAULT_ALIGN);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return alloc_counters::allocate(size, DEFAULT_ALIGN);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return alloc_counters::allocate(size, DEFAULT_ALIGN);
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    return alloc_counters::allocate_or_throw(size, static_cast<std::size_t>(align));
+}
+
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+    return alloc_counters::allocate_or_throw(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void* ptr) noexcept
+{
+    alloc_counters::deallocate(ptr, DEFAULT_ALIGN);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    alloc_counters::deallocate(ptr, DEFAULT_ALIGN);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    alloc_counters::deallocate(ptr, DEFAULT_ALIGN);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    alloc_counters::deallocate(ptr, DEFAULT_ALIGN);
+}
+
+void operator delete(void* ptr, std::align_val_t align) noexcept
+{
+    alloc_counters::deallocate(ptr, static_cast<std::size_t>(align));
+}
+
+void operator delete[](void* ptr, std::align_val_t align) noexcept
+{
+    alloc_counters::deallocate(ptr, static_cast<std::size_t>(align));
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t align) noexcept
+{
+    alloc_counters::deallocate(ptr, static_cast<std::size_t>(align));
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t align) noexcept
+{
+    alloc_counters::deallocate(ptr, static_cast<std::size_t>(align));
+}
+
+#endif
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench.h"
+#include "solver.h"
+
+// Registry of every day's entry points, for tools that link all the days'
+// solutions built with -DAOC_NO_MAIN.
+
+#define AOC_DECLARE_DAY(day)                                    \
+    namespace day {                                             \
+    void benchmark(Bench&, const std::string&);                 \
+    bool solve(std::string_view, std::ostream&);                \
+    std::unique_ptr<Solver> make_solver();                      \
+    }
+
+AOC_DECLARE_DAY(day_1)
+AOC_DECLARE_DAY(day_2)
+AOC_DECLARE_DAY(day_3)
+AOC_DECLARE_DAY(day_4)
+AOC_DECLARE_DAY(day_5)
+AOC_DECLARE_DAY(day_6)
+AOC_DECLARE_DAY(day_8)
+AOC_DECLARE_DAY(day_9)
+AOC_DECLARE_DAY(day_10)
+AOC_DECLARE_DAY(day_11)
+AOC_DECLARE_DAY(day_12)
+AOC_DECLARE_DAY(day_14)
+AOC_DECLARE_DAY(day_15)
+AOC_DECLARE_DAY(day_17)
+AOC_DECLARE_DAY(day_18)
+AOC_DECLARE_DAY(day_20)
+AOC_DECLARE_DAY(day_21)
+AOC_DECLARE_DAY(day_22)
+AOC_DECLARE_DAY(day_23)
+AOC_DECLARE_DAY(day_24)
+AOC_DECLARE_DAY(day_25)
+
+#undef AOC_DECLARE_DAY
+
+// Records the parse, part 1 and part 2 timings of one day's solution.
+using Benchmark = void (*)(Bench&, const std::string&);
+
+// Writes the answers for an input to a stream, returns false if one is not
+// found.
+using Solve = bool (*)(std::string_view, std::ostream&);
+
+// One day's solution.
+struct Day {
+    std::string name;
+    Benchmark benchmark;
+    Solve solve;
+    MakeSolver make_solver;
+    bool has_input = true;   // false if the puzzle input is built in
+};
+
+inline const std::vector<Day> DAYS = {
+    {"day_1", day_1::benchmark, day_1::solve, day_1::make_solver},
+    {"day_2", day_2::benchmark, day_2::solve, day_2::make_solver},
+    {"day_3", day_3::benchmark, day_3::solve, day_3::make_solver},
+    {"day_4", day_4::benchmark, day_4::solve, day_4::make_solver},
+    {"day_5", day_5::benchmark, day_5::solve, day_5::make_solver},
+    {"day_6", day_6::benchmark, day_6::solve, day_6::make_solver},
+    {"day_8", day_8::benchmark, day_8::solve, day_8::make_solver},
+    {"day_9", day_9::benchmark, day_9::solve, day_9::make_solver},
+    {"day_10", day_10::benchmark, day_10::solve, day_10::make_solver},
+    {"day_11", day_11::benchmark, day_11::solve, day_11::make_solver},
+    {"day_12", day_12::benchmark, day_12::solve, day_12::make_solver},
+    {"day_14", day_14::benchmark, day_14::solve, day_14::make_solver},
+    {"day_15", day_15::benchmark, day_15::solve, day_15::make_solver},
+    {"day_17", day_17::benchmark, day_17::solve, day_17::make_solver},
+    {"day_18", day_18::benchmark, day_18::solve, day_18::make_solver},
+    {"day_20", day_20::benchmark, day_20::solve, day_20::make_solver},
+    {"day_21", day_21::benchmark, day_21::solve, day_21::make_solver},
+    {"day_22", day_22::benchmark, day_22::solve, day_22::make_solver},
+    {"day_23", day_23::benchmark, day_23::solve, day_23::make_solver, false},
+    {"day_24", day_24::benchmark, day_24::solve, day_24::make_solver},
+    {"day_25", day_25::benchmark, day_25::solve, day_25::make_solver},
+};
+
+// Returns the Day registered under name or throws if there is none.
+inline const Day& find_day(const std::string& name)
+{
+    for (const auto& day : DAYS) {
+        if (day.name == name) {
+            return day;
+        }
+    }
+    throw std::invalid_argument{"unknown day " + name};
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+
+#include "input.h"
+
+// Compile-time parsing of puzzle inputs embedded in the program.
+//
+// Building a day with -DAOC_EMBED_INPUT compiles its input.txt into the
+// program as EMBEDDED_INPUT, from an input.inc file holding it as a raw string
+// literal:
+//
+//     cd day_N
+//     { printf 'R"aoc('; cat input.txt; printf ')aoc"'; } > input.inc
+//     g++ -std=c++17 -O2 -DAOC_EMBED_INPUT -o solution *.cpp
+//
+// Answers whose algorithms fit within the compiler's constexpr evaluation
+// limits are then computed during the build and the program only prints them;
+// an input without an answer fails the build. The remaining parts are solved
+// at run time from the embedded input.
+//
+// std::sort and the containers used by the run-time solutions are not
+// constexpr in C++17, so compile-time solutions work on std::array sized from
+// the input with the helpers below.
+
+// Returns the integer in s.
+//
+// Throws std::invalid_argument, which fails a compile-time evaluation, if s is
+// not exactly one integer.
+template <typename T = int>
+constexpr T to_int(std::string_view s)
+{
+    bool negative = !s.empty() && s.front() == '-';
+    if (negative) {
+        s.remove_prefix(1);
+    }
+    if (s.empty()) {
+        throw std::invalid_argument{"expected integer"};
+    }
+    T value = 0;
+    for (char c : s) {
+        if (c < '0' || c > '9') {
+            throw std::invalid_argument{"expected integer"};
+        }
+        value = value * 10 + (c - '0');
+    }
+    return negative ? -value : value;
+}
+
+// Returns the number of pieces in range, e.g. tokens(data) or lines(data).
+constexpr std::size_t count(const Split& range)
+{
+    std::size_t n = 0;
+    for (auto it = range.begin(); it != range.end(); ++it) {
+        n++;
+    }
+    return n;
+}
+
+// Returns the integers in the first N pieces of range.
+//
+// Throws std::invalid_argument if range has fewer than N pieces.
+template <typename T, std::size_t N>
+constexpr std::array<T, N> parse_ints(const Split& range)
+{
+    std::array<T, N> values{};
+    auto it = range.begin();
+    for (std::size_t i = 0; i < N; i++, ++it) {
+        if (it == range.end()) {
+            throw std::invalid_argument{"expected more integers"};
+        }
+        values[i] = to_int<T>(*it);
+    }
+    return values;
+}
+
+// Returns values sorted in ascending order.
+//
+// Insertion sort: quadratic, but the arrays sorted at compile time are small
+// and it keeps the evaluation simple.
+template <typename T, std::size_t N>
+constexpr std::array<T, N> sorted(std::array<T, N> values)
+{
+    for (std::size_t i = 1; i < N; i++) {
+        for (std::size_t j = i; j > 0 && values[j] < values[j - 1]; j--) {
+            auto tmp = values[j];
+            values[j] = values[j - 1];
+            values[j - 1] = tmp;
+        }
+    }
+    return values;
+}
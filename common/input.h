@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// A read-only, memory-mapped view of the contents of a file.
+//
+// Parsers take the std::string_view returned by data() and may keep views into
+// it, so the Input must outlive anything parsed from it.
+class Input {
+public:
+    explicit Input(const std::string& filepath)
+    {
+        int fd = ::open(filepath.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::invalid_argument{"unable to open " + filepath};
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == -1) {
+            ::close(fd);
+            throw std::invalid_argument{"unable to stat " + filepath};
+        }
+        size = st.st_size;
+        if (size > 0) {
+            void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                throw std::invalid_argument{"unable to map " + filepath};
+            }
+            ::madvise(addr, size, MADV_SEQUENTIAL);
+            mapped = static_cast<const char*>(addr);
+        }
+        ::close(fd);
+    }
+
+    Input(const Input&) = delete;
+    Input& operator=(const Input&) = delete;
+
+    ~Input()
+    {
+        if (mapped != nullptr) {
+            ::munmap(const_cast<char*>(mapped), size);
+        }
+    }
+
+    std::string_view data() const { return {mapped, size}; }
+
+private:
+    const char* mapped = nullptr;
+    std::size_t size = 0;
+};
+
+// A range over the pieces of a buffer separated by any of a set of delimiters.
+//
+// Pieces are views into the buffer, no copies are made. Splitting is constexpr
+// so inputs embedded in the program can be parsed at compile time.
+class Split {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = const std::string_view&;
+
+        // Past-the-end iterator.
+        constexpr iterator() = default;
+
+        constexpr iterator(std::string_view rest, std::string_view delims, bool skip_empty)
+            : rest{rest}, delims{delims}, skip_empty{skip_empty}, done{false}
+        {
+            ++*this;
+        }
+
+        constexpr reference operator*() const { return piece; }
+
+        constexpr pointer operator->() const { return &piece; }
+
+        constexpr iterator& operator++()
+        {
+            if (skip_empty) {
+                auto start = rest.find_first_not_of(delims);
+                rest.remove_prefix(start == rest.npos ? rest.size() : start);
+            }
+            if (rest.empty()) {
+                done = true;
+                return *this;
+            }
+            auto stop = rest.find_first_of(delims);
+            if (stop == rest.npos) {
+                piece = rest;
+                rest.remove_prefix(rest.size());
+            } else {
+                piece = rest.substr(0, stop);
+                rest.remove_prefix(stop + 1);
+            }
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+
+        friend constexpr bool operator==(const iterator& lhs, const iterator& rhs)
+        {
+            if (lhs.done || rhs.done) {
+                return lhs.done == rhs.done;
+            }
+            return lhs.rest.data() == rhs.rest.data();
+        }
+
+        friend constexpr bool operator!=(const iterator& lhs, const iterator& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        std::string_view rest;
+        std::string_view delims;
+        std::string_view piece;
+        bool skip_empty = false;
+        bool done = true;
+    };
+
+    constexpr Split(std::string_view data, std::string_view delims, bool skip_empty)
+        : data{data}, delims{delims}, skip_empty{skip_empty} { }
+
+    constexpr iterator begin() const { return {data, delims, skip_empty}; }
+
+    constexpr iterator end() const { return {}; }
+
+private:
+    std::string_view data;
+    std::string_view delims;
+    bool skip_empty;
+};
+
+// Returns a range over each line in data without its '\n'.
+//
+// Matches std::getline: blank lines are kept and a trailing '\n' does not
+// start an extra empty line.
+constexpr Split lines(std::string_view data)
+{
+    return {data, "\n", false};
+}
+
+// Returns a range over each non-empty token in data separated by delims.
+constexpr Split tokens(std::string_view data, std::string_view delims = " \t\r\n")
+{
+    return {data, delims, true};
+}
+
+// Returns each record in data, where records are separated by blank lines.
+inline std::vector<std::string_view> records(std::string_view data)
+{
+    std::vector<std::string_view> result;
+    while (!data.empty()) {
+        auto stop = data.find("\n\n");
+        if (stop == data.npos) {
+            if (data.back() == '\n') {
+                data.remove_suffix(1);
+            }
+            result.push_back(data);
+            break;
+        }
+        result.push_back(data.substr(0, stop));
+        data.remove_prefix(stop + 2);
+        data.remove_prefix(std::min(data.find_first_not_of('\n'), data.size()));
+    }
+    return result;
+}
+
+// Returns data split into at most n_parts contiguous pieces of about equal
+// size, each cut just after a delimiter so no line ("\n") or record ("\n\n")
+// is divided between pieces. Pieces are only empty if data is.
+inline std::vector<std::string_view> split_aligned(
+    std::string_view data, std::size_t n_parts, std::string_view delimiter = "\n"
+) {
+    std::vector<std::string_view> parts;
+    const auto size = data.size() / std::max<std::size_t>(n_parts, 1);
+    while (!data.empty()) {
+        auto cut = data.size();
+        if (parts.size() + 1 < n_parts && size < data.size()) {
+            auto found = data.find(delimiter, size);
+            if (found != data.npos) {
+                cut = found + delimiter.size();
+            }
+        }
+        parts.push_back(data.substr(0, cut));
+        data.remove_prefix(cut);
+    }
+    return parts;
+}
+
+// Returns the integer at the start of s and removes its characters from s.
+//
+// Throws std::invalid_argument if s does not start with an integer.
+template <typename T = int>
+T consume_int(std::string_view& s)
+{
+    T value{};
+    auto result = std::from_chars(s.data(), s.data() + s.size(), value);
+    if (result.ec != std::errc{}) {
+        throw std::invalid_argument{"expected integer: " + std::string{s}};
+    }
+    s.remove_prefix(result.ptr - s.data());
+    return value;
+}
+
+// Returns the integer in s.
+//
+// Throws std::invalid_argument if s is not exactly one integer.
+template <typename T = int>
+T parse_int(std::string_view s)
+{
+    auto rest = s;
+    T value = consume_int<T>(rest);
+    if (!rest.empty()) {
+        throw std::invalid_argument{"expected integer: " + std::string{s}};
+    }
+    return value;
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+// A JSON value, as read back from the reports the tools here write.
+struct Json {
+    enum class Type { null, boolean, number, string, array, object };
+
+    Type type = Type::null;
+    bool boolean = false;
+    double number = 0;
+    std::string string;
+    std::vector<Json> array;
+    std::vector<std::pair<std::string, Json>> object;   // in document order
+
+    // Returns the member called key, or nullptr if there is none or this is
+    // not an object.
+    const Json* find(std::string_view key) const
+    {
+        for (const auto& member : object) {
+            if (member.first == key) {
+                return &member.second;
+            }
+        }
+        return nullptr;
+    }
+
+    // Returns the member called key or throws if there is none.
+    const Json& at(std::string_view key) const
+    {
+        auto member = find(key);
+        if (member == nullptr) {
+            throw std::invalid_argument{"missing JSON member " + std::string{key}};
+        }
+        return *member;
+    }
+
+    // Returns the JSON document in text.
+    //
+    // Throws std::invalid_argument if text is not a single valid JSON value.
+    static Json parse(std::string_view text)
+    {
+        Parser parser{text};
+        auto value = parser.value();
+        parser.skip_space();
+        if (!parser.rest.empty()) {
+            parser.fail("trailing characters");
+        }
+        return value;
+    }
+
+private:
+    struct Parser {
+        std::string_view rest;
+
+        [[noreturn]] void fail(const std::string& what) const
+        {
+            throw std::invalid_argument{"invalid JSON: " + what};
+        }
+
+        void skip_space()
+        {
+            auto start = rest.find_first_not_of(" \t\r\n");
+            rest.remove_prefix(start == rest.npos ? rest.size() : start);
+        }
+
+        // Removes token from the start of rest, returns false if it is not
+        // there.
+        bool consume(std::string_view token)
+        {
+            if (rest.substr(0, token.size()) != token) {
+                return false;
+            }
+            rest.remove_prefix(token.size());
+            return true;
+        }
+
+        void expect(char c)
+        {
+            skip_space();
+            if (!consume({&c, 1})) {
+                fail(std::string{"expected '"} + c + "'");
+            }
+        }
+
+        Json value()
+        {
+            skip_space();
+            Json json;
+            if (rest.empty()) {
+                fail("unexpected end");
+            }
+            if (consume("null")) {
+                json.type = Type::null;
+            } else if (consume("true")) {
+                json.type = Type::boolean;
+                json.boolean = true;
+            } else if (consume("false")) {
+                json.type = Type::boolean;
+            } else if (rest.front() == '"') {
+                json.type = Type::string;
+                json.string = string();
+            } else if (consume("[")) {
+                json.type = Type::array;
+                skip_space();
+                if (!consume("]")) {
+                    do {
+                        json.array.push_back(value());
+                        skip_space();
+                    } while (consume(","));
+                    expect(']');
+                }
+            } else if (consume("{")) {
+                json.type = Type::object;
+                skip_space();
+                if (!consume("}")) {
+                    do {
+                        skip_space();
+                        auto key = string();
+                        expect(':');
+                        json.object.emplace_back(std::move(key), value());
+                        skip_space();
+                    } while (consume(","));
+                    expect('}');
+                }
+            } else {
+                json.type = Type::number;
+                json.number = number();
+            }
+            return json;
+        }
+
+        double number()
+        {
+            double value = 0;
+            auto result = std::from_chars(rest.data(), rest.data() + rest.size(), value);
+            if (result.ec != std::errc{}) {
+                fail("expected value at: " + std::string{rest.substr(0, 20)});
+            }
+            rest.remove_prefix(result.ptr - rest.data());
+            return value;
+        }
+
+        std::string string()
+        {
+            if (!consume("\"")) {
+                fail("expected string");
+            }
+            std::string result;
+            while (true) {
+                auto stop = rest.find_first_of("\"\\");
+                if (stop == rest.npos) {
+                    fail("unterminated string");
+                }
+                result.append(rest.substr(0, stop));
+                char c = rest[stop];
+                rest.remove_prefix(stop + 1);
+                if (c == '"') {
+                    return result;
+                }
+                if (rest.empty()) {
+                    fail("unterminated string");
+                }
+                char escape = rest.front();
+                rest.remove_prefix(1);
+                switch (escape) {
+                case '"': result += '"'; break;
+                case '\\': result += '\\'; break;
+                case '/': result += '/'; break;
+                case 'b': result += '\b'; break;
+                case 'f': result += '\f'; break;
+                case 'n': result += '\n'; break;
+                case 'r': result += '\r'; break;
+                case 't': result += '\t'; break;
+                case 'u': append_utf8(result, code_unit()); break;
+                default: fail(std::string{"unknown escape \\"} + escape);
+                }
+            }
+        }
+
+        // Returns the 4 hex digit code unit of a \u escape.
+        unsigned code_unit()
+        {
+            unsigned value = 0;
+            auto digits = rest.substr(0, 4);
+            auto result = std::from_chars(digits.data(), digits.data() + digits.size(), value, 16);
+            if (digits.size() != 4 || result.ptr != digits.data() + 4) {
+                fail("bad \\u escape");
+            }
+            rest.remove_prefix(4);
+            return value;
+        }
+
+        // Appends code point cp, which is below 0x10000, encoded as UTF-8.
+        // Surrogate pairs are not combined, the reports never contain them.
+        static void append_utf8(std::string& s, unsigned cp)
+        {
+            if (cp < 0x80) {
+                s += static_cast<char>(cp);
+            } else if (cp < 0x800) {
+                s += static_cast<char>(0xc0 | cp >> 6);
+                s += static_cast<char>(0x80 | (cp & 0x3f));
+            } else {
+                s += static_cast<char>(0xe0 | cp >> 12);
+                s += static_cast<char>(0x80 | (cp >> 6 & 0x3f));
+                s += static_cast<char>(0x80 | (cp & 0x3f));
+            }
+        }
+    };
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// A hardware counter's value over a measured region.
+struct PerfValue {
+    std::string name;
+    long long value;
+};
+
+namespace perf_events {
+
+// A hardware event to count, as given to perf_event_open(2).
+struct Event {
+    const char* name;
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+// Returns the config of a PERF_TYPE_HW_CACHE event counting read misses.
+constexpr std::uint64_t cache_miss(std::uint64_t cache)
+{
+    return cache
+        | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+inline constexpr Event ALL[] = {
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"l1d_misses", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D)},
+    {"llc_misses", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL)},
+    {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {"dtlb_misses", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_DTLB)},
+};
+
+} // namespace perf_events
+
+// Hardware performance counters for the calling thread, read through Linux
+// perf_event_open(2).
+//
+// Counters the kernel does not permit (see kernel.perf_event_paranoid) or the
+// CPU does not support are skipped and listed by unavailable(), so callers can
+// always use the counters that remain, possibly none.
+class PerfCounters {
+public:
+    PerfCounters()
+    {
+        for (const auto& event : perf_events::ALL) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = event.type;
+            attr.config = event.config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            int fd = ::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+            if (fd == -1) {
+                missing.push_back(event.name);
+            } else {
+                counters.emplace_back(event.name, fd);
+            }
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters()
+    {
+        for (const auto& counter : counters) {
+            ::close(counter.second);
+        }
+    }
+
+    // Returns the names of the counters that could not be opened.
+    const std::vector<std::string>& unavailable() const { return missing; }
+
+    // Resets and starts all counters.
+    void start()
+    {
+        for (const auto& counter : counters) {
+            ::ioctl(counter.second, PERF_EVENT_IOC_RESET, 0);
+        }
+        for (const auto& counter : counters) {
+            ::ioctl(counter.second, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    // Stops all counters and returns their values since start().
+    //
+    // When the kernel had to share hardware counters between events, values
+    // are scaled up from the fraction of time each was counting. Counters
+    // that never got to count are left out.
+    std::vector<PerfValue> stop()
+    {
+        for (const auto& counter : counters) {
+            ::ioctl(counter.second, PERF_EVENT_IOC_DISABLE, 0);
+        }
+
+        std::vector<PerfValue> values;
+        for (const auto& counter : counters) {
+            std::uint64_t data[3];    // value, time enabled, time running
+            if (::read(counter.second, data, sizeof(data)) != sizeof(data) || data[2] == 0) {
+                continue;
+            }
+            auto value = data[0];
+            if (data[2] < data[1]) {
+                value = static_cast<std::uint64_t>(
+                    static_cast<double>(value) * data[1] / data[2]
+                );
+            }
+            values.push_back({counter.first, static_cast<long long>(value)});
+        }
+        return values;
+    }
+
+private:
+    std::vector<std::pair<std::string, int>> counters;   // name and fd
+    std::vector<std::string> missing;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// A small deterministic pseudo-random number generator (SplitMix64).
+//
+// The standard library's distributions and std::shuffle are free to differ
+// between implementations, so everything here is built on the raw 64-bit
+// stream to give the same sequence for a seed on every machine.
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed) : state{seed} { }
+
+    // Returns the next 64 random bits.
+    std::uint64_t next()
+    {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    // Returns an integer uniformly distributed in [lower, upper].
+    long long uniform(long long lower, long long upper)
+    {
+        auto range = static_cast<std::uint64_t>(upper - lower) + 1;
+        if (range == 0) {
+            return static_cast<long long>(next());
+        }
+        // reject the top partial range to avoid modulo bias
+        auto limit = UINT64_MAX - UINT64_MAX % range;
+        std::uint64_t x;
+        do {
+            x = next();
+        } while (x >= limit);
+        return lower + static_cast<long long>(x % range);
+    }
+
+    // Returns true with probability p.
+    bool chance(double p)
+    {
+        return (next() >> 11) * 0x1.0p-53 < p;
+    }
+
+    // Returns a uniformly chosen element of values.
+    template <typename T>
+    const T& pick(const std::vector<T>& values)
+    {
+        return values[uniform(0, values.size() - 1)];
+    }
+
+    // Shuffles values in place (Fisher-Yates).
+    template <typename T>
+    void shuffle(std::vector<T>& values)
+    {
+        for (std::size_t i = values.size(); i > 1; i--) {
+            std::swap(values[i - 1], values[uniform(0, i - 1)]);
+        }
+    }
+
+private:
+    std::uint64_t state;
+};
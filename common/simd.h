@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define AOC_SIMD_X86
+#endif
+
+// Byte-scanning kernels built for several instruction sets, with the widest
+// the running CPU supports chosen the first time each is called. A program
+// built without -march flags still uses AVX2 where it is available.
+
+namespace simd {
+
+// Returns the number of bytes of s equal to c, one byte at a time.
+inline std::size_t count_char_scalar(std::string_view s, char c)
+{
+    std::size_t n = 0;
+    for (char x : s) {
+        n += x == c;
+    }
+    return n;
+}
+
+#ifdef AOC_SIMD_X86
+// Returns the number of bytes of s equal to c, 16 at a time. SSE2 is part of
+// x86-64 so it needs no check.
+inline std::size_t count_char_sse2(std::string_view s, char c)
+{
+    const auto needle = _mm_set1_epi8(c);
+    std::size_t n = 0;
+    std::size_t i = 0;
+    for (; i + 16 <= s.size(); i += 16) {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s.data() + i));
+        auto mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        n += __builtin_popcount(mask);
+    }
+    return n + count_char_scalar(s.substr(i), c);
+}
+
+// Returns the number of bytes of s equal to c, 32 at a time.
+__attribute__((target("avx2,popcnt")))
+inline std::size_t count_char_avx2(std::string_view s, char c)
+{
+    const auto needle = _mm256_set1_epi8(c);
+    std::size_t n = 0;
+    std::size_t i = 0;
+    for (; i + 32 <= s.size(); i += 32) {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.data() + i));
+        auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+        n += __builtin_popcount(mask);
+    }
+    return n + count_char_sse2(s.substr(i), c);
+}
+#endif
+
+using CountChar = std::size_t (*)(std::string_view, char);
+
+// Returns the widest count_char kernel the running CPU supports.
+inline CountChar select_count_char()
+{
+#ifdef AOC_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+        return count_char_avx2;
+    }
+    return count_char_sse2;
+#else
+    return count_char_scalar;
+#endif
+}
+
+} // namespace simd
+
+// Returns the number of bytes of s equal to c.
+inline std::size_t count_char(std::string_view s, char c)
+{
+    static const simd::CountChar kernel = simd::select_count_char();
+    return kernel(s, c);
+}
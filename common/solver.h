@@ -0,0 +1,41 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <string_view>
+
+// A day's solution split into its parse, part 1 and part 2 phases.
+//
+// Each day implements this over its own parsed representation, so a driver
+// can run any day and time or profile each phase without knowing its types.
+// The parts write their answers exactly as the day's solve() prints them;
+// running all three phases in order reproduces its output.
+class Solver {
+public:
+    virtual ~Solver() = default;
+
+    // Parses input, which may be referenced by the parsed state and so must
+    // outlive the solver.
+    virtual void parse(std::string_view input) = 0;
+
+    // Writes the answer to part 1 to os, returns false if it is not found.
+    virtual bool part_1(std::ostream& os) = 0;
+
+    // Writes the answer to part 2 to os, returns false if it is not found.
+    virtual bool part_2(std::ostream& os) = 0;
+
+    // Returns the version of the answers this solver gives. Bump it when a
+    // fix changes them, so answers cached from earlier versions are not used.
+    virtual int version() const { return 1; }
+
+    // Parses input and writes the answers to both parts to os, returns false
+    // if one is not found.
+    bool solve(std::string_view input, std::ostream& os)
+    {
+        parse(input);
+        return part_1(os) && part_2(os);
+    }
+};
+
+// Returns a new Solver for one day, ready to parse an input.
+using MakeSolver = std::unique_ptr<Solver> (*)();
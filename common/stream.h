@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+// Bytes read from a stream at a time by for_each_chunk().
+constexpr std::size_t STREAM_CHUNK_SIZE = 1 << 16;
+
+// Reads fd to its end in chunks of about chunk_size bytes, cut after the last
+// delimiter in each so no line ("\n") or record ("\n\n") is split between
+// chunks, and calls f(chunk) with each as a std::string_view.
+//
+// Only one chunk is held in memory, plus the start of the next that followed
+// its last delimiter. The views passed to f are invalidated when it returns.
+// A piece longer than chunk_size grows the buffer to hold it.
+template <typename F>
+void for_each_chunk(int fd, std::string_view delimiter, F f, std::size_t chunk_size = STREAM_CHUNK_SIZE)
+{
+    std::vector<char> buffer(chunk_size);
+    std::size_t size = 0;
+    bool eof = false;
+
+    while (!eof) {
+        // fill the buffer, pipes may return less than asked for
+        while (size < buffer.size()) {
+            auto n = ::read(fd, buffer.data() + size, buffer.size() - size);
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            if (n == -1) {
+                throw std::runtime_error{std::string{"unable to read input: "} + std::strerror(errno)};
+            }
+            if (n == 0) {
+                eof = true;
+                break;
+            }
+            size += n;
+        }
+
+        std::string_view data{buffer.data(), size};
+        if (eof) {
+            if (!data.empty()) {
+                f(data);
+            }
+            break;
+        }
+
+        auto last = data.rfind(delimiter);
+        if (last == data.npos) {
+            buffer.resize(buffer.size() * 2);
+            continue;
+        }
+        auto cut = last + delimiter.size();
+        f(data.substr(0, cut));
+        std::memmove(buffer.data(), buffer.data() + cut, size - cut);
+        size -= cut;
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads that run batches of indexed tasks.
+//
+// Each worker owns a deque of task indices. It takes tasks from the front of
+// its own deque and, once that is empty, steals from the back of the other
+// workers' deques so uneven task costs still keep every worker busy.
+class ThreadPool {
+public:
+    // Function run for each task: f(task, worker) where worker is in
+    // [0, size()) and identifies the thread running the task.
+    using Task = std::function<void(std::size_t, std::size_t)>;
+
+    explicit ThreadPool(std::size_t n_threads = std::thread::hardware_concurrency())
+        : queues(std::max<std::size_t>(n_threads, 1))
+    {
+        for (std::size_t i = 0; i < queues.size(); i++) {
+            workers.emplace_back([this, i] { work_loop(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stopping = true;
+        }
+        start.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    std::size_t size() const { return queues.size(); }
+
+    // Runs f for each task in [0, n_tasks) and returns once all have run.
+    //
+    // If any task throws, the first exception is rethrown once the remaining
+    // tasks have run.
+    void run(std::size_t n_tasks, Task f)
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+
+        // workers are idle, deal tasks out round-robin
+        for (std::size_t task = 0; task < n_tasks; task++) {
+            queues[task % queues.size()].tasks.push_back(task);
+        }
+        job = std::move(f);
+        error = nullptr;
+        n_running = workers.size();
+        generation++;
+        start.notify_all();
+
+        done.wait(lock, [this] { return n_running == 0; });
+        job = nullptr;
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+    };
+
+    std::vector<Queue> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;               // guards all members below
+    std::condition_variable start;
+    std::condition_variable done;
+    Task job;
+    std::exception_ptr error;
+    std::size_t n_running = 0;
+    std::size_t generation = 0;
+    bool stopping = false;
+
+    void work_loop(std::size_t worker)
+    {
+        std::size_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                start.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+            }
+
+            std::size_t task;
+            while (pop(worker, task) || steal(worker, task)) {
+                try {
+                    job(task, worker);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock{mutex};
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+
+            std::lock_guard<std::mutex> lock{mutex};
+            if (--n_running == 0) {
+                done.notify_all();
+            }
+        }
+    }
+
+    // Takes the next task from the front of the worker's own queue.
+    bool pop(std::size_t worker, std::size_t& task)
+    {
+        auto& queue = queues[worker];
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    // Takes a task from the back of another worker's queue.
+    bool steal(std::size_t worker, std::size_t& task)
+    {
+        for (std::size_t i = 1; i < queues.size(); i++) {
+            auto& queue = queues[(worker + i) % queues.size()];
+            std::lock_guard<std::mutex> lock{queue.mutex};
+            if (!queue.tasks.empty()) {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+};
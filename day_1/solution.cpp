@@ -1,85 +1,668 @@
 /* Day 1: Report Repair.
  *
+ * Parse: O(n log n) to sort the values once
  * Part 1: O(n)
- * Part 2: Average case n^2
+ * Part 2: O(n^2)
  *
  */
-#include <fstream>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
 #include <optional>
-#include <unordered_set>
-#include <unordered_map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../common/bench.h"
+#include "../common/embed.h"
+#include "../common/input.h"
+#include "../common/solver.h"
+#include "../common/thread_pool.h"
 
-using std::unordered_map;
-using std::unordered_multiset;
-using std::ifstream;
 using std::optional;
+using std::string;
+using std::string_view;
+using std::vector;
+
+namespace day_1 {
+
+constexpr int TARGET = 2020;
+
+// Returns the multiple of the two values in the sorted range [first, last)
+// that sum to target if they exist.
+//
+// Walks inward from both ends: a sum that is too small can only grow by
+// dropping the smallest value, one too large only shrink by dropping the
+// largest. Each value is used at most once, so a value pairs with itself
+// only if it appears twice.
+template <typename It>
+constexpr optional<int> mult_pair(It first, It last, const int target)
+{
+    if (first == last) {
+        return std::nullopt;
+    }
+    --last;
+    while (first < last) {
+        auto sum = *first + *last;
+        if (sum == target) {
+            return *first * *last;
+        }
+        if (sum < target) {
+            ++first;
+        } else {
+            --last;
+        }
+    }
+    return std::nullopt;
+}
+
+// Returns the multiple of the three values in the sorted range [first, last)
+// that sum to target if they exist.
+template <typename It>
+constexpr optional<int> mult_triple(It first, It last, const int target)
+{
+    for (; first != last; ++first) {
+        if (3LL * *first > target) {
+            // the other two values are at least as large
+            break;
+        }
+        auto result = mult_pair(first + 1, last, target - *first);
+        if (result) {
+            return *first * *result;
+        }
+    }
+    return std::nullopt;
+}
+
+// The expense report: its values sorted in ascending order and, when their
+// range is dense enough, a bitmap of those present.
+struct Report {
+    vector<int> values;
+    vector<bool> present;   // present[v - values.front()], empty if sparse
+};
+
+// Bits of bitmap allowed per value: at 64 it is no larger than the values.
+constexpr std::size_t MAX_BITS_PER_VALUE = 64;
+
+// Returns the integer values in input, in order.
+vector<int> parse_values(string_view input)
+{
+    vector<int> values;
+    for (auto token : tokens(input)) {
+        values.push_back(parse_int(token));
+    }
+    return values;
+}
+
+// Returns the report of the integer values in input.
+Report parse_input(string_view input)
+{
+    Report report;
+    report.values = parse_values(input);
+    auto& values = report.values;
+    std::sort(values.begin(), values.end());
+
+    if (!values.empty()) {
+        auto range = static_cast<long long>(values.back()) - values.front() + 1;
+        if (static_cast<unsigned long long>(range) <= MAX_BITS_PER_VALUE * values.size()) {
+            report.present.resize(range);
+            for (auto v : values) {
+                report.present[v - values.front()] = true;
+            }
+        }
+    }
+    return report;
+}
+
+// Returns the multiple of the two values from index first on in the report
+// that sum to target if they exist.
+//
+// With a bitmap each value looks up its complement directly instead of
+// walking towards it from the other end.
+optional<int> mult_pair(const Report& report, std::size_t first, const int target)
+{
+    const auto& values = report.values;
+    if (report.present.empty()) {
+        return mult_pair(values.begin() + first, values.end(), target);
+    }
+
+    for (auto i = first; i < values.size(); i++) {
+        auto v = values[i];
+        auto w = static_cast<long long>(target) - v;
+        if (w < v) {
+            // every later pair would have been found with w first
+            break;
+        }
+        if (w == v) {
+            if (i + 1 < values.size() && values[i + 1] == v) {
+                return v * v;
+            }
+            continue;
+        }
+        // w > v >= values.front(), so w is within the bitmap unless too large
+        if (w <= values.back() && report.present[w - values.front()]) {
+            return v * static_cast<int>(w);
+        }
+    }
+    return std::nullopt;
+}
+
+// Returns the multiple of the two values in the report that sum to target if
+// they exist.
+optional<int> mult_pair(const Report& report, const int target)
+{
+    return mult_pair(report, 0, target);
+}
+
+// Returns the multiple of the three values in the report that sum to target if
+// they exist.
+optional<int> mult_triple(const Report& report, const int target)
+{
+    const auto& values = report.values;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        if (3LL * values[i] > target) {
+            break;
+        }
+        auto result = mult_pair(report, i + 1, target - values[i]);
+        if (result) {
+            return values[i] * *result;
+        }
+    }
+    return std::nullopt;
+}
+
+// k entries of a report that sum to a target.
+struct KSum {
+    vector<std::size_t> indices;   // positions of the entries, ascending
+    optional<long long> product;   // empty if it overflows a long long
+};
+
+// Largest k accepted by k_sum().
+constexpr std::size_t MAX_K = 6;
+
+// Largest number of half sums k_sum() lists for either half.
+constexpr unsigned long long MAX_HALF_SUMS = 1 << 22;
+
+// The sum of up to MAX_K / 2 values, by their positions in the candidates.
+struct HalfSum {
+    long long sum;
+    std::array<std::uint32_t, (MAX_K + 1) / 2> positions;
+};
+
+// Returns the sums of every size-value subset of the sorted values, sorted by
+// sum.
+vector<HalfSum> half_sums(const vector<int>& values, std::size_t size)
+{
+    vector<HalfSum> sums;
+    HalfSum current{0, {}};
+
+    // adds the values from position on to current until it has size of them
+    auto extend = [&](auto& self, std::size_t depth, std::size_t position) -> void {
+        if (depth == size) {
+            sums.push_back(current);
+            return;
+        }
+        for (auto i = position; i + (size - depth) <= values.size(); i++) {
+            current.positions[depth] = i;
+            current.sum += values[i];
+            self(self, depth + 1, i + 1);
+            current.sum -= values[i];
+        }
+    };
+    extend(extend, 0, 0);
+
+    std::sort(sums.begin(), sums.end(), [](const HalfSum& a, const HalfSum& b) {
+        return a.sum < b.sum;
+    });
+    return sums;
+}
+
+// Returns the number of size-value subsets of n values, or MAX_HALF_SUMS + 1
+// if there are more than MAX_HALF_SUMS.
+unsigned long long n_subsets(std::size_t n, std::size_t size)
+{
+    unsigned long long count = 1;
+    for (std::size_t i = 1; i <= size; i++) {
+        // count * (n - size + i) / i stays a whole number at each step
+        count = count * (n - size + i) / i;
+        if (count > MAX_HALF_SUMS) {
+            return MAX_HALF_SUMS + 1;
+        }
+    }
+    return count;
+}
+
+// Returns a times b, or nothing if that overflows a long long.
+optional<long long> checked_multiply(long long a, long long b)
+{
+    if (a != 0 && b != 0) {
+        constexpr auto MAX = std::numeric_limits<long long>::max();
+        constexpr auto MIN = std::numeric_limits<long long>::min();
+        bool positive = (a > 0) == (b > 0);
+        if (positive ? (a > 0 ? a > MAX / b : a < MAX / b)
+                     : (a > 0 ? b < MIN / a : a < MIN / b)) {
+            return std::nullopt;
+        }
+    }
+    return a * b;
+}
 
+// Returns true and appends to chosen the positions of k values of the sorted
+// values, from position first on, that sum to target, if there are any.
+//
+// Fixes the values one at a time in ascending order, skipping repeats and any
+// value whose smallest or largest completion misses target, down to the last
+// two, which are found with the pair scan.
+bool scan_k_sum(
+    const vector<int>& values,
+    std::size_t first,
+    std::size_t k,
+    long long target,
+    vector<std::uint32_t>& chosen
+) {
+    const auto n = values.size();
+    if (n - first < k) {
+        return false;
+    }
+    if (k == 1) {
+        auto it = std::lower_bound(values.begin() + first, values.end(), target);
+        if (it == values.end() || *it != target) {
+            return false;
+        }
+        chosen.push_back(it - values.begin());
+        return true;
+    }
+    if (k == 2) {
+        auto i = first;
+        auto j = n - 1;
+        while (i < j) {
+            auto sum = static_cast<long long>(values[i]) + values[j];
+            if (sum == target) {
+                chosen.push_back(i);
+                chosen.push_back(j);
+                return true;
+            }
+            sum < target ? i++ : j--;
+        }
+        return false;
+    }
+
+    // the sum of the k - 1 largest values
+    long long largest = 0;
+    for (std::size_t i = 1; i < k; i++) {
+        largest += values[n - i];
+    }
+    for (auto p = first; p + k <= n; p++) {
+        long long smallest = 0;
+        for (auto i = p; i < p + k; i++) {
+            smallest += values[i];
+        }
+        if (smallest > target) {
+            break;
+        }
+        if ((p > first && values[p] == values[p - 1]) || values[p] + largest < target) {
+            continue;
+        }
+        chosen.push_back(p);
+        if (scan_k_sum(values, p + 1, k - 1, target - values[p], chosen)) {
+            return true;
+        }
+        chosen.pop_back();
+    }
+    return false;
+}
 
-// Returns the multiple of the two numbers that sum to target if they exist.
-optional<int> mult_pair(const unordered_multiset<int> &vals, const int target)
+// Returns k entries of values, each used at most once, that sum to target if
+// there are any.
+//
+// Meet in the middle: every subset of k values splits into its k / 2 smallest
+// and the rest, so sorted lists of the sums of each half are walked inward
+// from both ends like a pair search. Only values that can be in a subset
+// summing to target are listed, which bounds the lists by the values near the
+// target rather than by the size of the input.
+//
+// When a half would have more than MAX_HALF_SUMS sums, scan_k_sum() searches
+// instead. It stops at the first answer, but proving there is none takes
+// O(n^(k - 1)) time in the worst case.
+//
+// Throws std::invalid_argument if k is not in [1, MAX_K].
+optional<KSum> k_sum(const vector<int>& values, std::size_t k, long long target)
 {
-    unordered_map<int, int> diffs;
-    for (const auto val : vals) {
-        diffs[val] = target - val;
+    if (k < 1 || k > MAX_K) {
+        throw std::invalid_argument{"k must be in [1, " + std::to_string(MAX_K) + "]"};
+    }
+    if (values.size() < k) {
+        return std::nullopt;
+    }
+
+    vector<std::size_t> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](auto a, auto b) {
+        return values[a] < values[b];
+    });
+
+    // v can be in a subset only if v plus the k - 1 smallest values is not
+    // above target and v plus the k - 1 largest is not below it
+    long long smallest = 0;
+    long long largest = 0;
+    for (std::size_t i = 0; i + 1 < k; i++) {
+        smallest += values[order[i]];
+        largest += values[order[order.size() - 1 - i]];
+    }
+    vector<int> candidates;
+    vector<std::size_t> candidate_indices;
+    for (auto i : order) {
+        if (values[i] + smallest <= target && values[i] + largest >= target) {
+            candidates.push_back(values[i]);
+            candidate_indices.push_back(i);
+        }
     }
 
-    // Search through all diffs and see if any exists in the original set of
-    // vals, if so the total sums to target.
-    for (const auto &d : diffs) {
-        auto search = diffs.find(d.second);
-        if (search != diffs.end()) {
-            return d.first * d.second;
+    if (candidates.size() < k) {
+        return std::nullopt;
+    }
+
+    // returns the entries at positions of the candidates
+    auto make_result = [&](const vector<std::uint32_t>& positions) {
+        KSum result{{}, 1LL};
+        for (auto position : positions) {
+            result.indices.push_back(candidate_indices[position]);
+            if (result.product) {
+                result.product = checked_multiply(*result.product, candidates[position]);
+            }
         }
+        std::sort(result.indices.begin(), result.indices.end());
+        return result;
+    };
+
+    const auto low_size = k / 2;
+    const auto high_size = k - low_size;
+    if (n_subsets(candidates.size(), high_size) > MAX_HALF_SUMS) {
+        vector<std::uint32_t> positions;
+        if (!scan_k_sum(candidates, 0, k, target, positions)) {
+            return std::nullopt;
+        }
+        return make_result(positions);
     }
+    const auto low = half_sums(candidates, low_size);
+    const auto high = half_sums(candidates, high_size);
+
+    // the low half's largest position must precede the high half's smallest
+    auto joins = [&](const HalfSum& l, const HalfSum& h) {
+        return low_size == 0 || l.positions[low_size - 1] < h.positions[0];
+    };
+
+    std::size_t i = 0;
+    auto j = high.size();
+    while (i < low.size() && j > 0) {
+        auto sum = low[i].sum + high[j - 1].sum;
+        if (sum < target) {
+            i++;
+            continue;
+        }
+        if (sum > target) {
+            j--;
+            continue;
+        }
 
+        // try every pair in the runs of equal sums
+        auto i_end = i;
+        while (i_end < low.size() && low[i_end].sum == low[i].sum) {
+            i_end++;
+        }
+        auto j_begin = j - 1;
+        while (j_begin > 0 && high[j_begin - 1].sum == high[j - 1].sum) {
+            j_begin--;
+        }
+        for (auto l = i; l < i_end; l++) {
+            for (auto h = j_begin; h < j; h++) {
+                if (!joins(low[l], high[h])) {
+                    continue;
+                }
+                vector<std::uint32_t> positions(
+                    low[l].positions.begin(), low[l].positions.begin() + low_size
+                );
+                positions.insert(
+                    positions.end(), high[h].positions.begin(), high[h].positions.begin() + high_size
+                );
+                return make_result(positions);
+            }
+        }
+        i = i_end;
+        j = j_begin;
+    }
     return std::nullopt;
 }
 
+#ifdef AOC_EMBED_INPUT
+// The puzzle input compiled into the program, see common/embed.h.
+constexpr string_view EMBEDDED_INPUT =
+#include "input.inc"
+    ;
 
-int main()
+constexpr auto EMBEDDED_VALUES = sorted(
+    parse_ints<int, count(tokens(EMBEDDED_INPUT))>(tokens(EMBEDDED_INPUT))
+);
+
+constexpr auto EMBEDDED_PART_1 = mult_pair(
+    EMBEDDED_VALUES.begin(), EMBEDDED_VALUES.end(), TARGET
+);
+static_assert(EMBEDDED_PART_1, "no two values sum to TARGET");
+
+constexpr auto EMBEDDED_PART_2 = mult_triple(
+    EMBEDDED_VALUES.begin(), EMBEDDED_VALUES.end(), TARGET
+);
+static_assert(EMBEDDED_PART_2, "no three values sum to TARGET");
+#endif
+
+void benchmark(Bench& bench, const string& filepath)
 {
-    // Read integer values from file into multiset.
-    ifstream data{"input.txt"};
-    unordered_multiset<int> vals;
-    int val;
-    while (data >> val) {
-        vals.insert(val);
+    const Input input{filepath};
+    const auto report = bench.phase("parse", [&] { return parse_input(input.data()); });
+    bench.phase("part_1", [&] { return mult_pair(report, TARGET); });
+    bench.phase("part_2", [&] { return mult_triple(report, TARGET); });
+}
+
+// Solver holding the parsed report between phases.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override
+    {
+        // Read integer values from file into a sorted report.
+        report = parse_input(input);
     }
 
     // Part 1: find two values that sum to TARGET and output their multiple.
-    const int TARGET = 2020;
-    auto result = mult_pair(vals, TARGET);
-    if (!result) {
-        std::cout << "Failed to find two values that sum to "
-                  << TARGET
-                  << std::endl;
-        return 1;
+    bool part_1(std::ostream& os) override
+    {
+        auto result = mult_pair(report, TARGET);
+        if (!result) {
+            os << "Failed to find two values that sum to "
+               << TARGET
+               << std::endl;
+            return false;
+        }
+        os << *result << std::endl;
+        return true;
     }
-    std::cout << *result << std::endl;
 
     // Part 2: find three values that sum to TARGET and output their multiple.
+    bool part_2(std::ostream& os) override
+    {
+        auto result = mult_triple(report, TARGET);
+        if (!result) {
+            os << "Failed to find three values that sum to "
+               << TARGET
+               << std::endl;
+            return false;
+        }
+        os << *result << std::endl;
+        return true;
+    }
 
-    // Copy vals so it can be modified during the loop without invalidating the
-    // iterator.
-    auto tmp_vals = vals;
-
-    for (const auto v1 : vals) {
-        // Reuse solution from Part 1: For each value, form a new set that does
-        // not contain the value and a new target that is the original target
-        // minus the value. Then we only need to find two values that sum to
-        // this new target.
-        auto v1_target = TARGET - v1;
-        tmp_vals.extract(v1);
-        auto result = mult_pair(tmp_vals, v1_target);
-        if (result) {
-            std::cout << v1 * *result << std::endl;
-            return 0;
+    // 2: a value is no longer paired with itself, so a lone 1010 is not an
+    // answer.
+    int version() const override { return 2; }
+
+private:
+    Report report;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os, returns false if one is not found.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+// Writes the product of k values in input that sum to target and their
+// positions, counting from 0, to os. Returns false if there are none or the
+// search fails.
+bool write_k_sum(string_view input, std::size_t k, long long target, std::ostream& os)
+{
+    optional<KSum> result;
+    try {
+        result = k_sum(parse_values(input), k, target);
+    } catch (const std::exception& e) {
+        os << "error: " << e.what() << std::endl;
+        return false;
+    }
+    if (!result) {
+        os << "Failed to find " << k << " values that sum to " << target << std::endl;
+        return false;
+    }
+    if (result->product) {
+        os << *result->product;
+    } else {
+        os << "overflow";
+    }
+    for (auto i : result->indices) {
+        os << ' ' << i;
+    }
+    os << std::endl;
+    return true;
+}
+
+// Answers to both parts for one target.
+struct TargetAnswers {
+    int target;
+    optional<int> pair;
+    optional<int> triple;
+};
+
+// Returns the answers to both parts for each of targets, searched in report
+// on the threads of pool.
+//
+// The report is built once and only read, so the threads share it. Targets
+// are split into contiguous blocks, a few per thread, each writing only its
+// own answers.
+vector<TargetAnswers> answer_targets(
+    const Report& report, const vector<int>& targets, ThreadPool& pool
+) {
+    vector<TargetAnswers> answers(targets.size());
+    const auto block = std::max<std::size_t>(1, targets.size() / (pool.size() * 8));
+    const auto n_blocks = (targets.size() + block - 1) / block;
+
+    pool.run(n_blocks, [&](std::size_t task, std::size_t /* worker */) {
+        auto end = std::min(targets.size(), (task + 1) * block);
+        for (auto i = task * block; i < end; i++) {
+            answers[i] = {targets[i], mult_pair(report, targets[i]), mult_triple(report, targets[i])};
+        }
+    });
+    return answers;
+}
+
+// Writes the answers to both parts for each of targets over the values in
+// input to os, one "target pair triple" line each with "-" for a missing
+// answer, and the number answered per second to log. Returns false if any
+// answer is missing.
+bool write_targets(
+    string_view input,
+    const vector<int>& targets,
+    std::size_t n_threads,
+    std::ostream& os,
+    std::ostream& log
+) {
+    const auto report = parse_input(input);
+    ThreadPool pool(n_threads);
+
+    auto start = std::chrono::steady_clock::now();
+    auto answers = answer_targets(report, targets, pool);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    bool all_found = true;
+    auto write = [&](const optional<int>& answer) {
+        all_found = all_found && answer;
+        if (answer) {
+            os << ' ' << *answer;
+        } else {
+            os << " -";
         }
-        tmp_vals.insert(v1);
+    };
+    for (const auto& answer : answers) {
+        os << answer.target;
+        write(answer.pair);
+        write(answer.triple);
+        os << '\n';
     }
+    os.flush();
+
+    log << targets.size() << " targets in " << std::fixed << std::setprecision(3)
+        << elapsed.count() * 1e3 << " ms on " << pool.size() << " threads: "
+        << std::setprecision(0) << targets.size() / elapsed.count() << " targets/s"
+        << std::endl;
+    return all_found;
+}
+
+} // namespace day_1
 
-    std::cout << "Failed to find three values that sum to "
-              << TARGET
-              << std::endl;
+#ifndef AOC_NO_MAIN
+// Usage:
+//
+//     solution                                    # both parts for TARGET
+//     solution k target                           # k_sum()
+//     solution --targets FILE [--threads N]       # answer_targets()
+//
+// --targets answers both parts for each target in FILE, one per line, on N
+// threads (default: one per hardware thread) and writes the throughput to
+// stderr. Build with -pthread.
+int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
+{
+#ifdef AOC_EMBED_INPUT
+    // Both answers were found by the compiler.
+    std::cout << *day_1::EMBEDDED_PART_1 << '\n' << *day_1::EMBEDDED_PART_2 << std::endl;
+    return 0;
+#else
+    const Input input{"input.txt"};
+    if (argc >= 3 && string_view{argv[1]} == "--targets") {
+        std::size_t n_threads = std::thread::hardware_concurrency();
+        if (argc == 5 && string_view{argv[3]} == "--threads") {
+            n_threads = std::stoul(argv[4]);
+        }
+        const Input targets{argv[2]};
+        return day_1::write_targets(
+            input.data(), day_1::parse_values(targets.data()), n_threads, std::cout, std::cerr
+        ) ? 0 : 1;
+    }
+    if (argc == 3) {
+        return day_1::write_k_sum(
+            input.data(), std::stoul(argv[1]), std::stoll(argv[2]), std::cout
+        ) ? 0 : 1;
+    }
+    return day_1::solve(input.data(), std::cout) ? 0 : 1;
+#endif
 }
+#endif
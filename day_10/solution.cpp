@@ -1,15 +1,41 @@
 #include <algorithm>
-#include <fstream>
+#include <array>
+#include <cstddef>
 #include <iostream>
-#include <iterator>
+#include <memory>
 #include <stdexcept>
 #include <unordered_map>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "../common/bench.h"
+#include "../common/embed.h"
+#include "../common/input.h"
+#include "../common/solver.h"
+
+using std::string;
+using std::string_view;
 using std::vector;
-using std::ifstream;
 using std::unordered_map;
 
+namespace day_10 {
+
+// Returns the sorted adapter ratings in input, including the charging
+// outlet's effective rating of 0.
+vector<int> parse_input(string_view input)
+{
+    vector<int> adapters = {0};
+
+    for (auto token : tokens(input)) {
+        adapters.push_back(parse_int(token));
+    }
+
+    std::sort(adapters.begin(), adapters.end());
+
+    return adapters;
+}
+
 // Returns a map of <difference between two adapters: number of occurences>.
 unordered_map<int, int> get_diff_count(const vector<int>& adapters)
 {
@@ -40,22 +66,128 @@ unsigned long iter_n_arrange(const vector<int>& adapters) {
     return counts[adapters.size() - 1];
 }
 
-int main()
+// Returns the number of 1-jolt differences multiplied by the number of 3-jolt
+// differences.
+int mult_diff_count(const vector<int>& adapters)
 {
-    ifstream data{"input.txt"};
+    auto diff_count = get_diff_count(adapters);
+    return diff_count[1] * diff_count[3];
+}
 
-    vector<int> adapters = {0};
+namespace compile_time {
 
-    std::copy(
-        std::istream_iterator<int>(data),
-        std::istream_iterator<int>(),
-        std::back_inserter(adapters)
-    );
+// Returns the ratings in input with the outlet's 0, sorted like parse_input().
+template <std::size_t N>
+constexpr std::array<int, N + 1> parse_input(string_view input)
+{
+    std::array<int, N + 1> adapters{};
+    auto values = parse_ints<int, N>(tokens(input));
+    for (std::size_t i = 0; i < N; i++) {
+        adapters[i + 1] = values[i];
+    }
+    return sorted(adapters);
+}
 
-    std::sort(adapters.begin(), adapters.end());
+// Returns the number of 1-jolt differences multiplied by the number of 3-jolt
+// differences.
+template <std::size_t N>
+constexpr int mult_diff_count(const std::array<int, N>& adapters)
+{
+    int diff_count[4] = {};
+    int jolt = 0;
+    for (auto adapter : adapters) {
+        if (adapter - jolt > 3) {
+            throw std::invalid_argument("");
+        }
+        diff_count[adapter - jolt]++;
+        jolt = adapter;
+    }
+    diff_count[3]++;   // built-in adapter rated 3 higher
+    return diff_count[1] * diff_count[3];
+}
 
-    auto diff_count = get_diff_count(adapters);
+// Returns the number of distinct arrangements of the adapters.
+template <std::size_t N>
+constexpr unsigned long iter_n_arrange(const std::array<int, N>& adapters)
+{
+    std::array<unsigned long, N> counts{};
+    counts[0] = 1;
+    for (std::size_t i = 0; i < N; i++) {
+        for (auto j = i + 1; j < N && adapters[j] - adapters[i] <= 3; j++) {
+            counts[j] += counts[i];
+        }
+    }
+    return counts[N - 1];
+}
+
+} // namespace compile_time
+
+#ifdef AOC_EMBED_INPUT
+// The puzzle input compiled into the program, see common/embed.h.
+constexpr string_view EMBEDDED_INPUT =
+#include "input.inc"
+    ;
+
+constexpr auto EMBEDDED_ADAPTERS =
+    compile_time::parse_input<count(tokens(EMBEDDED_INPUT))>(EMBEDDED_INPUT);
+
+constexpr auto EMBEDDED_PART_1 = compile_time::mult_diff_count(EMBEDDED_ADAPTERS);
+
+constexpr auto EMBEDDED_PART_2 = compile_time::iter_n_arrange(EMBEDDED_ADAPTERS);
+#endif
+
+void benchmark(Bench& bench, const string& filepath)
+{
+    const Input input{filepath};
+    const auto adapters = bench.phase("parse", [&] { return parse_input(input.data()); });
+    bench.phase("part_1", [&] { return mult_diff_count(adapters); });
+    bench.phase("part_2", [&] { return iter_n_arrange(adapters); });
+}
+
+// Solver holding the parsed adapters between phases.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { adapters = parse_input(input); }
 
-    std::cout << diff_count[1] * diff_count[3] << std::endl;
-    std::cout << iter_n_arrange(adapters) << std::endl;
+    bool part_1(std::ostream& os) override
+    {
+        os << mult_diff_count(adapters) << std::endl;
+        return true;
+    }
+
+    bool part_2(std::ostream& os) override
+    {
+        os << iter_n_arrange(adapters) << std::endl;
+        return true;
+    }
+
+private:
+    vector<int> adapters;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+} // namespace day_10
+
+#ifndef AOC_NO_MAIN
+int main()
+{
+#ifdef AOC_EMBED_INPUT
+    // Both answers were found by the compiler.
+    std::cout << day_10::EMBEDDED_PART_1 << '\n' << day_10::EMBEDDED_PART_2 << std::endl;
+    return 0;
+#else
+    const Input input{"input.txt"};
+    return day_10::solve(input.data(), std::cout) ? 0 : 1;
+#endif
 }
+#endif
@@ -1,13 +1,21 @@
-#include <fstream>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
-using std::istream;
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/solver.h"
+
 using std::ostream;
 using std::string;
+using std::string_view;
 using std::vector;
 
+namespace day_11 {
+
 class SeatMap {
 public:
     enum class SeatStatus{
@@ -27,13 +35,14 @@ public:
         return total;
     }
 
-    friend istream& operator>>(istream&, SeatMap&);
+    friend SeatMap parse_input(string_view input);
     friend ostream& operator<<(ostream&, const SeatMap&);
 private:
     int n_steps;
     int n_rows;
     int n_cols;
     vector<SeatStatus> status;
+    vector<SeatStatus> next_status;     // scratch space reused by step()
 
     int n_occupied(int row, int col, bool first_seat) const
     {
@@ -67,20 +76,21 @@ private:
     }
 };
 
-istream& operator>>(istream& is, SeatMap& sm)
+// Returns the SeatMap in input.
+SeatMap parse_input(string_view input)
 {
     int n_rows = 0;
     int n_cols = -1;
     vector<SeatMap::SeatStatus> status;
 
-    string line;
-
-    while (getline(is, line)) {
+    for (auto line : lines(input)) {
+        if (line.empty()) {
+            continue;
+        }
         if (n_cols == -1) {
             n_cols = line.size();
         } else if (static_cast<int>(line.size()) != n_cols) {
-            is.clear(std::ios::failbit);
-            return is;
+            throw std::invalid_argument{"rows must have equal length"};
         }
 
         n_rows++;
@@ -97,18 +107,18 @@ istream& operator>>(istream& is, SeatMap& sm)
                 status.push_back(SeatMap::SeatStatus::FLOOR);
                 break;
             default:
-                is.clear(std::ios::failbit);
-                return is;
+                throw std::invalid_argument{"unknown seat status"};
             };
         }
     }
 
+    SeatMap sm;
     sm.n_steps = 0;
     sm.n_rows = n_rows;
     sm.n_cols = n_cols;
     sm.status = status;
 
-    return is;
+    return sm;
 }
 
 ostream& operator<<(ostream& os, const SeatMap& sm)
@@ -140,7 +150,7 @@ ostream& operator<<(ostream& os, const SeatMap& sm)
 bool SeatMap::step(bool first_seat, int min_occupied)
 {
     bool seat_change = false;
-    vector<SeatStatus> new_status{status};
+    next_status.assign(status.begin(), status.end());
 
     for (auto i = 0; i < n_rows; i++) {
         for (auto j = 0; j < n_cols; j++) {
@@ -149,13 +159,13 @@ bool SeatMap::step(bool first_seat, int min_occupied)
             case SeatStatus::EMPTY:
                 if (n_occupied(i, j, first_seat) == 0) {
                     seat_change = true;
-                    new_status[i*n_cols + j] = SeatStatus::OCCUPIED;
+                    next_status[i*n_cols + j] = SeatStatus::OCCUPIED;
                 }
                 break;
             case SeatStatus::OCCUPIED:
                 if (n_occupied(i, j, first_seat) >= min_occupied) {
                     seat_change = true;
-                    new_status[i*n_cols + j] = SeatStatus::EMPTY;
+                    next_status[i*n_cols + j] = SeatStatus::EMPTY;
                 }
                 break;
             case SeatStatus::FLOOR:
@@ -164,23 +174,63 @@ bool SeatMap::step(bool first_seat, int min_occupied)
         }
     }
 
-    status = new_status;
+    status.swap(next_status);
     return seat_change;
 }
 
-int main()
+// Returns the number of occupied seats once the seats stop changing.
+int n_occupied_when_stable(SeatMap sm, bool first_seat, int min_occupied)
+{
+    while (sm.step(first_seat, min_occupied));
+    return sm.n_equal(SeatMap::SeatStatus::OCCUPIED);
+}
+
+void benchmark(Bench& bench, const string& filepath)
 {
-    // Part 1
-    std::ifstream data{"input.txt"};
+    const Input input{filepath};
+    const auto sm = bench.phase("parse", [&] { return parse_input(input.data()); });
+    bench.phase("part_1", [&] { return n_occupied_when_stable(sm, false, 4); });
+    bench.phase("part_2", [&] { return n_occupied_when_stable(sm, true, 5); });
+}
+
+// Solver holding the parsed seat map between phases.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { sm = parse_input(input); }
+
+    bool part_1(std::ostream& os) override
+    {
+        os << n_occupied_when_stable(sm, false, 4) << std::endl;
+        return true;
+    }
+
+    bool part_2(std::ostream& os) override
+    {
+        os << n_occupied_when_stable(sm, true, 5) << std::endl;
+        return true;
+    }
+
+private:
     SeatMap sm;
-    data >> sm;
-    while (sm.step(false, 4));
-    std::cout << sm.n_equal(SeatMap::SeatStatus::OCCUPIED) << std::endl;
-
-    // Part 2
-    data.clear();
-    data.seekg(0);
-    data >> sm;
-    while (sm.step(true, 5));
-    std::cout << sm.n_equal(SeatMap::SeatStatus::OCCUPIED) << std::endl;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+} // namespace day_11
+
+#ifndef AOC_NO_MAIN
+int main()
+{
+    const Input input{"input.txt"};
+    return day_11::solve(input.data(), std::cout) ? 0 : 1;
 }
+#endif
@@ -2,15 +2,21 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <string>
 
-std::istream& operator>>(std::istream& is, Instruction& ins)
+#include "../common/input.h"
+
+namespace day_12 {
+
+Instruction parse_instruction(std::string_view line)
 {
+    if (line.empty()) {
+        throw std::invalid_argument{"empty instruction"};
+    }
+
     Instruction::Action act;
-    Instruction::Value val;
 
-    char a;
-    is >> a;
-    switch (a) {
+    switch (line[0]) {
     case 'N':
         act = Instruction::Action::N;
         break;
@@ -33,20 +39,14 @@ std::istream& operator>>(std::istream& is, Instruction& ins)
         act = Instruction::Action::F;
         break;
     default:
-        is.unget();
-        is.clear(std::ios::failbit);
-        return is;
+        throw std::invalid_argument{"unknown action: " + std::string{line}};
     };
 
-    is >> val;
-    if (is.fail()) {
-        return is;
-    }
-
+    Instruction ins;
     ins.action = act;
-    ins.value = val;
+    ins.value = parse_int<Instruction::Value>(line.substr(1));
 
-    return is;
+    return ins;
 }
 
 std::ostream& operator<<(std::ostream& os, const Instruction& ins)
@@ -209,3 +209,5 @@ void WaypointShip::turn(const int clockwise)
         waypoint_lat = tmp_long;
     }
 }
+
+} // namespace day_12
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <iostream>
+#include <string_view>
+
+namespace day_12 {
 
 class Instruction {
 public:
@@ -14,7 +17,9 @@ public:
     Value value;
 };
 
-std::istream& operator>>(std::istream& is, Instruction& ins);
+// Returns the Instruction in a line of the form "F10".
+Instruction parse_instruction(std::string_view line);
+
 std::ostream& operator<<(std::ostream& os, const Instruction& ins);
 
 class Ship {
@@ -68,3 +73,5 @@ private:
 
     void turn(const int clockwise);
 };
+
+} // namespace day_12
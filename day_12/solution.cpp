@@ -1,25 +1,163 @@
-#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
+#include "../common/bench.h"
+#include "../common/embed.h"
+#include "../common/input.h"
+#include "../common/solver.h"
 #include "ship.h"
 
-int main()
+using std::string;
+using std::string_view;
+using std::vector;
+
+namespace day_12 {
+
+// Returns the navigation instructions in input.
+vector<Instruction> parse_input(string_view input)
+{
+    vector<Instruction> instructions;
+    for (auto token : tokens(input)) {
+        instructions.push_back(parse_instruction(token));
+    }
+    return instructions;
+}
+
+// Returns the Manhattan distance of ship from its start after following the
+// instructions.
+int manhattan_dist(Ship&& ship, const vector<Instruction>& instructions)
+{
+    for (const auto& ins : instructions) {
+        ship.move(ins);
+    }
+    return std::abs(ship.get_latitude()) + std::abs(ship.get_longitude());
+}
+
+namespace compile_time {
+
+// Returns the Manhattan distance of a ship from its start after following the
+// instructions in input as an AbsoluteShip or, with waypoint, a WaypointShip.
+//
+// Both ships move forward along a vector that turns clockwise as
+// (lat, long) -> (long, -lat): a unit vector facing east for AbsoluteShip,
+// the waypoint for WaypointShip, which N/S/E/W then move instead of the ship.
+constexpr int manhattan_dist(string_view input, bool waypoint)
+{
+    int latitude = 0;
+    int longitude = 0;
+    int forward_lat = waypoint ? 10 : 1;
+    int forward_long = waypoint ? 1 : 0;
+
+    for (auto token : tokens(input)) {
+        auto value = to_int(token.substr(1));
+        int& move_lat = waypoint ? forward_lat : latitude;
+        int& move_long = waypoint ? forward_long : longitude;
+
+        switch (token[0]) {
+        case 'N':
+            move_long += value;
+            break;
+        case 'S':
+            move_long -= value;
+            break;
+        case 'E':
+            move_lat += value;
+            break;
+        case 'W':
+            move_lat -= value;
+            break;
+        case 'L':
+            value = -value;
+            [[fallthrough]];
+        case 'R':
+            if (value % 90 != 0) {
+                throw std::invalid_argument{"turns must be 90 degrees"};
+            }
+            for (auto n_rots = (value % 360 + 360) % 360 / 90; n_rots > 0; n_rots--) {
+                auto tmp_long = forward_long;
+                forward_long = -forward_lat;
+                forward_lat = tmp_long;
+            }
+            break;
+        case 'F':
+            latitude += value * forward_lat;
+            longitude += value * forward_long;
+            break;
+        default:
+            throw std::invalid_argument{"unknown action"};
+        }
+    }
+    return (latitude < 0 ? -latitude : latitude) + (longitude < 0 ? -longitude : longitude);
+}
+
+} // namespace compile_time
+
+#ifdef AOC_EMBED_INPUT
+// The puzzle input compiled into the program, see common/embed.h.
+constexpr string_view EMBEDDED_INPUT =
+#include "input.inc"
+    ;
+
+constexpr auto EMBEDDED_PART_1 = compile_time::manhattan_dist(EMBEDDED_INPUT, false);
+
+constexpr auto EMBEDDED_PART_2 = compile_time::manhattan_dist(EMBEDDED_INPUT, true);
+#endif
+
+void benchmark(Bench& bench, const string& filepath)
 {
-    std::ifstream data{"input.txt"};
+    const Input input{filepath};
+    const auto instructions = bench.phase("parse", [&] { return parse_input(input.data()); });
+    bench.phase("part_1", [&] { return manhattan_dist(AbsoluteShip(), instructions); });
+    bench.phase("part_2", [&] { return manhattan_dist(WaypointShip(), instructions); });
+}
+
+// Solver holding the parsed instructions between phases.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { instructions = parse_input(input); }
 
-    Instruction ins;
-    AbsoluteShip as;
-    WaypointShip ws;
+    bool part_1(std::ostream& os) override
+    {
+        os << manhattan_dist(AbsoluteShip(), instructions) << std::endl;
+        return true;
+    }
 
-    while (data >> ins) {
-        as.move(ins);
-        ws.move(ins);
+    bool part_2(std::ostream& os) override
+    {
+        os << manhattan_dist(WaypointShip(), instructions) << std::endl;
+        return true;
     }
 
-    // Part 1
-    auto manhattan_dist = std::abs(as.get_latitude()) + std::abs(as.get_longitude());
-    std::cout << manhattan_dist << std::endl;
+private:
+    vector<Instruction> instructions;
+};
 
-    // Part 2
-    manhattan_dist = std::abs(ws.get_latitude()) + std::abs(ws.get_longitude());
-    std::cout << manhattan_dist << std::endl;
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+} // namespace day_12
+
+#ifndef AOC_NO_MAIN
+int main()
+{
+#ifdef AOC_EMBED_INPUT
+    // Both answers were found by the compiler.
+    std::cout << day_12::EMBEDDED_PART_1 << '\n' << day_12::EMBEDDED_PART_2 << std::endl;
+    return 0;
+#else
+    const Input input{"input.txt"};
+    return day_12::solve(input.data(), std::cout) ? 0 : 1;
+#endif
 }
+#endif
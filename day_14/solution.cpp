@@ -1,17 +1,24 @@
 #include <bitset>
 #include <cmath>
-#include <fstream>
 #include <iostream>
+#include <memory>
 #include <numeric>
-#include <regex>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/solver.h"
+
 using std::string;
+using std::string_view;
 using std::vector;
 
+namespace day_14 {
+
 constexpr int ValueSize = 36;
 using Value = std::bitset<ValueSize>;
 using Memory = std::unordered_map<Value, Value>;
@@ -33,53 +40,57 @@ struct Instruction {
     Value value;
 };
 
-// Returns a vector of Instruction's from the file at filepath.
-vector<Instruction> parse_input(string filepath)
+// Returns the Instruction in a line of the form "mask = X10..." or
+// "mem[8] = 11".
+Instruction parse_instruction(string_view line)
 {
-    std::ifstream data{filepath};
-
-    if (!data) {
-        throw std::invalid_argument{"unable to open filepath"};
-    }
+    constexpr string_view MASK = "mask = ";
+    constexpr string_view STORE = "mem[";
 
-    std::regex match{
-        "(mask) = ([0X1]{36})|(mem)\\[(\\d+)\\] = (\\d+)"
-    };
-    std::smatch results;
-    string line;
-    vector<Instruction> instructions;
-    while (getline(data, line)) {
-        if (!std::regex_match(line, results, match)) {
+    Instruction ins;
+    if (line.substr(0, MASK.size()) == MASK) {
+        line.remove_prefix(MASK.size());
+        if (line.size() != ValueSize) {
             throw std::invalid_argument{"invalid input line"};
         }
-        if (results[1].matched) {
-            // MASK
-            Instruction ins;
-            ins.type = Instruction::Type::MASK;
-            for (int i = 0; i < ValueSize; i++) {
-                switch (*(results[2].first + i)) {
-                case '0':
-                    ins.mask_0[ValueSize - i - 1] = 1;
-                    break;
-                case '1':
-                    ins.mask_1[ValueSize - i - 1] = 1;
-                    break;
-                case 'X':
-                    ins.mask_X[ValueSize - i - 1] = 1;
-                    break;
-                }
+        ins.type = Instruction::Type::MASK;
+        for (int i = 0; i < ValueSize; i++) {
+            switch (line[i]) {
+            case '0':
+                ins.mask_0[ValueSize - i - 1] = 1;
+                break;
+            case '1':
+                ins.mask_1[ValueSize - i - 1] = 1;
+                break;
+            case 'X':
+                ins.mask_X[ValueSize - i - 1] = 1;
+                break;
+            default:
+                throw std::invalid_argument{"invalid input line"};
             }
-            instructions.push_back(ins);
-        } else if (results[3].matched) {
-            // STORE
-            Instruction ins;
-            ins.type = Instruction::Type::STORE;
-            ins.address = std::stoi(results[4].str());
-            ins.value = std::stoi(results[5].str());
-            instructions.push_back(ins);
         }
+    } else if (line.substr(0, STORE.size()) == STORE) {
+        line.remove_prefix(STORE.size());
+        ins.type = Instruction::Type::STORE;
+        ins.address = consume_int<unsigned long long>(line);
+        if (line.substr(0, 4) != "] = ") {
+            throw std::invalid_argument{"invalid input line"};
+        }
+        ins.value = parse_int<unsigned long long>(line.substr(4));
+    } else {
+        throw std::invalid_argument{"invalid input line"};
     }
 
+    return ins;
+}
+
+// Returns a vector of Instruction's from input.
+vector<Instruction> parse_input(string_view input)
+{
+    vector<Instruction> instructions;
+    for (auto line : lines(input)) {
+        instructions.push_back(parse_instruction(line));
+    }
     return instructions;
 }
 
@@ -175,15 +186,60 @@ unsigned long long sum_memory(Memory &memory)
     return total;
 }
 
-int main()
+void benchmark(Bench& bench, const string& filepath)
+{
+    const Input input{filepath};
+    const auto instructions = bench.phase("parse", [&] { return parse_input(input.data()); });
+    bench.phase("part_1", [&] {
+        auto memory = simulate_v1(instructions);
+        return sum_memory(memory);
+    });
+    bench.phase("part_2", [&] {
+        auto memory = simulate_v2(instructions);
+        return sum_memory(memory);
+    });
+}
+
+// Solver holding the parsed program between phases.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { instructions = parse_input(input); }
+
+    bool part_1(std::ostream& os) override
+    {
+        auto memory = simulate_v1(instructions);
+        os << sum_memory(memory) << std::endl;
+        return true;
+    }
+
+    bool part_2(std::ostream& os) override
+    {
+        auto memory = simulate_v2(instructions);
+        os << sum_memory(memory) << std::endl;
+        return true;
+    }
+
+private:
+    vector<Instruction> instructions;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
 {
-    auto instructions = parse_input("input.txt");
+    return Solution{}.solve(input, os);
+}
 
-    // Part 1
-    auto memory_v1 = simulate_v1(instructions);
-    std::cout << sum_memory(memory_v1) << std::endl;
+} // namespace day_14
 
-    // Part 2
-    auto memory_v2 = simulate_v2(instructions);
-    std::cout << sum_memory(memory_v2) << std::endl;
+#ifndef AOC_NO_MAIN
+int main()
+{
+    const Input input{"input.txt"};
+    return day_14::solve(input.data(), std::cout) ? 0 : 1;
 }
+#endif
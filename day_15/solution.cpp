@@ -1,27 +1,28 @@
-#include <fstream>
+#include <array>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include "../common/bench.h"
+#include "../common/embed.h"
+#include "../common/input.h"
+#include "../common/solver.h"
+
 using std::string;
+using std::string_view;
 using std::vector;
 
-vector<int> parse_input(string filepath)
+namespace day_15 {
+
+vector<int> parse_input(string_view input)
 {
-    std::ifstream data{filepath};
-    if (!data) {
-        throw std::invalid_argument{"unable to open file"};
-    }
     vector<int> numbers;
-    int number;
-    while (data >> number) {
-        numbers.push_back(number);
-        data.get();
-    }
-    if (!data.eof()) {
-        throw std::invalid_argument{"failed to parse input"};
+    for (auto token : tokens(input, ",\n")) {
+        numbers.push_back(parse_int(token));
     }
     return numbers;
 }
@@ -54,15 +55,102 @@ int number_at_turn(const vector<int>& starting_numbers, const int target_turn)
     return last_number;
 }
 
-int main()
+namespace compile_time {
+
+// Returns the number spoken on TargetTurn starting from the numbers in input,
+// like number_at_turn() but recording the turns in an array: every number
+// spoken after the start is an age below TargetTurn.
+template <int TargetTurn>
+constexpr int number_at_turn(string_view input)
+{
+    std::array<int, TargetTurn> last_spoken{};   // 0 if not spoken yet
+
+    int last_turn = 0;
+    int last_number = 0;
+    for (auto token : tokens(input, ",\n")) {
+        last_number = to_int(token);
+        if (last_number < 0 || last_number >= TargetTurn) {
+            throw std::out_of_range{"starting number out of range"};
+        }
+        last_spoken[last_number] = ++last_turn;
+    }
+
+    while (last_turn < TargetTurn) {
+        auto seen = last_spoken[last_number];
+        auto next = seen == 0 ? 0 : last_turn - seen;
+        last_spoken[last_number] = last_turn++;
+        last_number = next;
+    }
+    return last_number;
+}
+
+} // namespace compile_time
+
+#ifdef AOC_EMBED_INPUT
+// The puzzle input compiled into the program, see common/embed.h.
+constexpr string_view EMBEDDED_INPUT =
+#include "input.inc"
+    ;
+
+// Part 2's 30 million turns are far beyond the compiler's evaluation limits.
+constexpr auto EMBEDDED_PART_1 = compile_time::number_at_turn<2020>(EMBEDDED_INPUT);
+#endif
+
+void benchmark(Bench& bench, const string& filepath)
 {
-    const auto starting_numbers = parse_input("input.txt");
+    const Input input{filepath};
+    const auto numbers = bench.phase("parse", [&] { return parse_input(input.data()); });
+    bench.phase("part_1", [&] { return number_at_turn(numbers, 2020); });
+    bench.phase("part_2", [&] { return number_at_turn(numbers, 30'000'000); });
+}
 
-    // Part 1
-    auto number = number_at_turn(starting_numbers, 2020);
-    std::cout << number << std::endl;
+// Solver holding the starting numbers between phases.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { starting_numbers = parse_input(input); }
+
+    bool part_1(std::ostream& os) override
+    {
+        os << number_at_turn(starting_numbers, 2020) << std::endl;
+        return true;
+    }
 
-    // Part 2
-    number = number_at_turn(starting_numbers, 30'000'000);
-    std::cout << number << std::endl;
+    bool part_2(std::ostream& os) override
+    {
+        os << number_at_turn(starting_numbers, 30'000'000) << std::endl;
+        return true;
+    }
+
+private:
+    vector<int> starting_numbers;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+} // namespace day_15
+
+#ifndef AOC_NO_MAIN
+int main()
+{
+#ifdef AOC_EMBED_INPUT
+    // Part 1 was found by the compiler, part 2 is solved from the embedded
+    // input.
+    std::cout << day_15::EMBEDDED_PART_1 << std::endl;
+    day_15::Solution solution;
+    solution.parse(day_15::EMBEDDED_INPUT);
+    return solution.part_2(std::cout) ? 0 : 1;
+#else
+    const Input input{"input.txt"};
+    return day_15::solve(input.data(), std::cout) ? 0 : 1;
+#endif
 }
+#endif
@@ -1,11 +1,18 @@
 #include <array>
 #include <cmath>
-#include <fstream>
 #include <iostream>
-#include <stdexcept>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/solver.h"
+
+namespace day_17 {
 
 template <unsigned int N>
 struct Position {
@@ -24,11 +31,13 @@ struct Position {
 template <unsigned int N>
 using Grid = std::unordered_set<Position<N>>;
 
+} // namespace day_17
+
 namespace std {
 
     template<unsigned int N>
-    struct hash<Position<N>> {
-        std::size_t operator()(const Position<N>& pos) const
+    struct hash<day_17::Position<N>> {
+        std::size_t operator()(const day_17::Position<N>& pos) const
         {
             std::size_t value = 0;
             for (int i = 0; i < N; i++) {
@@ -40,19 +49,15 @@ namespace std {
 
 }
 
+namespace day_17 {
+
 template <unsigned int N>
-Grid<N> parse_input(std::string filepath)
+Grid<N> parse_input(std::string_view input)
 {
-    std::ifstream data{filepath};
-    if (!data) {
-        throw std::invalid_argument{"failed to open filepath"};
-    }
-
     Grid<N> grid;
     Position<N> pos{};
-    std::string line;
 
-    while (getline(data, line)) {
+    for (auto line : lines(input)) {
         for (const char &c : line) {
             switch (c) {
             case '.':
@@ -112,19 +117,69 @@ Grid<N> cycle(const Grid<N>& grid)
     return new_grid;
 }
 
-int main()
+// Returns the number of active cubes after n_cycles cycles.
+template <unsigned int N>
+size_t n_active_after(Grid<N> grid, int n_cycles)
 {
-    // Part 1
-    Grid<3> grid3d = parse_input<3>("input.txt");
-    for (int i = 0; i < 6; i++) {
-        grid3d = cycle(grid3d);
+    for (int i = 0; i < n_cycles; i++) {
+        grid = cycle(grid);
+    }
+    return grid.size();
+}
+
+void benchmark(Bench& bench, const std::string& filepath)
+{
+    const Input input{filepath};
+    const auto grids = bench.phase("parse", [&] {
+        return std::make_pair(parse_input<3>(input.data()), parse_input<4>(input.data()));
+    });
+    bench.phase("part_1", [&] { return n_active_after(grids.first, 6); });
+    bench.phase("part_2", [&] { return n_active_after(grids.second, 6); });
+}
+
+// Solver holding the initial 3D and 4D grids between phases.
+class Solution : public Solver {
+public:
+    void parse(std::string_view input) override
+    {
+        grid3d = parse_input<3>(input);
+        grid4d = parse_input<4>(input);
+    }
+
+    bool part_1(std::ostream& os) override
+    {
+        os << n_active_after(grid3d, 6) << std::endl;
+        return true;
     }
-    std::cout << grid3d.size() << std::endl;
 
-    // Part 2
-    Grid<4> grid4d = parse_input<4>("input.txt");
-    for (int i = 0; i < 6; i++) {
-        grid4d = cycle(grid4d);
+    bool part_2(std::ostream& os) override
+    {
+        os << n_active_after(grid4d, 6) << std::endl;
+        return true;
     }
-    std::cout << grid4d.size() << std::endl;
+
+private:
+    Grid<3> grid3d;
+    Grid<4> grid4d;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(std::string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+} // namespace day_17
+
+#ifndef AOC_NO_MAIN
+int main()
+{
+    const Input input{"input.txt"};
+    return day_17::solve(input.data(), std::cout) ? 0 : 1;
 }
+#endif
@@ -1,14 +1,22 @@
-#include <fstream>
 #include <iostream>
+#include <memory>
 #include <stack>
 #include <stdexcept>
 #include <string>
-#include <sstream>
+#include <string_view>
 #include <vector>
 
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/solver.h"
+#include "../common/stream.h"
+
 using std::string;
+using std::string_view;
 using std::vector;
 
+namespace day_18 {
+
 class Instruction {
 public:
     enum class Type {
@@ -45,19 +53,14 @@ public:
     }
 };
 
-vector<Instruction> parse_input(std::istream& data)
+vector<Instruction> parse_input(string_view expression)
 {
     vector<Instruction> instructions;
 
     bool proc_value = false;
     long long value = 0;
-    char c;
 
-    while (true) {
-        c = data.get();
-        if (data.eof()) {
-            break;
-        }
+    for (char c : expression) {
         switch (c) {
         case '0': case '1': case '2': case '3': case '4': case '5':
         case '6': case '7': case '8': case '9':
@@ -244,28 +247,95 @@ Instruction evaluate_part2(const vector<Instruction>& instructions)
     return operand_stack.top();
 }
 
+// Returns the instructions for each expression in input.
+vector<vector<Instruction>> parse_homework(string_view input)
+{
+    vector<vector<Instruction>> homework;
+    for (auto line : lines(input)) {
+        homework.push_back(parse_input(line));
+    }
+
+    return homework;
+}
+
+// Returns the sum of the results of evaluating each expression.
 long long process_homework(
-    string filepath,
+    const vector<vector<Instruction>>& homework,
     Instruction (&evaluate)(const vector<Instruction>& instructions)
 ) {
-    std::ifstream data{filepath};
-    if (!data) {
-        throw std::invalid_argument{"unable to open filepath"};
-    }
-
-    string line;
     long long total = 0;
-    while (getline(data, line)) {
-        std::stringstream ss{line};
-        const auto instructions = parse_input(ss);
+    for (const auto& instructions : homework) {
         total += evaluate(instructions).value;
     }
 
     return total;
 }
 
-int main()
+void benchmark(Bench& bench, const string& filepath)
 {
-    std::cout << process_homework("input.txt", evaluate_part1) << std::endl;
-    std::cout << process_homework("input.txt", evaluate_part2) << std::endl;
+    const Input input{filepath};
+    const auto homework = bench.phase("parse", [&] { return parse_homework(input.data()); });
+    bench.phase("part_1", [&] { return process_homework(homework, evaluate_part1); });
+    bench.phase("part_2", [&] { return process_homework(homework, evaluate_part2); });
+}
+
+// Solver holding the parsed homework between phases.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { homework = parse_homework(input); }
+
+    bool part_1(std::ostream& os) override
+    {
+        os << process_homework(homework, evaluate_part1) << std::endl;
+        return true;
+    }
+
+    bool part_2(std::ostream& os) override
+    {
+        os << process_homework(homework, evaluate_part2) << std::endl;
+        return true;
+    }
+
+private:
+    vector<vector<Instruction>> homework;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+// Writes the answers for the input read from fd to os, holding only a chunk of
+// it in memory at a time.
+bool solve_stream(int fd, std::ostream& os)
+{
+    long long total_part1 = 0;
+    long long total_part2 = 0;
+    for_each_chunk(fd, "\n", [&](string_view chunk) {
+        auto homework = parse_homework(chunk);
+        total_part1 += process_homework(homework, evaluate_part1);
+        total_part2 += process_homework(homework, evaluate_part2);
+    });
+    os << total_part1 << std::endl << total_part2 << std::endl;
+    return true;
+}
+
+} // namespace day_18
+
+#ifndef AOC_NO_MAIN
+// Reads input.txt, or stdin when the only argument is "-".
+int main(int argc, char* argv[])
+{
+    if (argc == 2 && string_view{argv[1]} == "-") {
+        return day_18::solve_stream(0, std::cout) ? 0 : 1;
+    }
+    const Input input{"input.txt"};
+    return day_18::solve(input.data(), std::cout) ? 0 : 1;
 }
+#endif
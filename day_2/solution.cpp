@@ -1,11 +1,25 @@
-#include <algorithm>
-#include <fstream>
+#include <array>
+#include <bitset>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/simd.h"
+#include "../common/solver.h"
+#include "../common/stream.h"
+#include "../common/thread_pool.h"
 
-using std::ifstream;
-using std::istream;
 using std::string;
+using std::string_view;
+using std::vector;
+
+namespace day_2 {
 
 struct Policy {
     int lower;
@@ -13,52 +27,367 @@ struct Policy {
     char c;
 };
 
-istream &operator>>(istream &is, Policy &p)
+// A password and the policy that was in place when it was set.
+struct Entry {
+    Policy policy;
+    string_view password;
+};
+
+// Returns the entry in a line of the form "1-3 a: abcde".
+Entry parse_entry(string_view line)
 {
-    char sep;
+    Entry entry;
+    auto &p = entry.policy;
 
-    is >> p.lower;
+    p.lower = consume_int(line);
+    if (line.size() < 2 || line[0] != '-') {
+        throw std::invalid_argument{"expected '-' after lower bound"};
+    }
+    line.remove_prefix(1);
 
-    is >> sep;
-    if (sep != '-') {
-        is.putback(sep);
-        is.clear(std::istream::failbit);
-        return is;
+    p.upper = consume_int(line);
+    if (line.size() < 4 || line[0] != ' ' || line[2] != ':' || line[3] != ' ') {
+        throw std::invalid_argument{"expected ' c: ' after upper bound"};
     }
+    p.c = line[1];
 
-    is >> p.upper;
+    line.remove_prefix(4);  // skip space, character, colon and space
+    entry.password = line;
 
-    is >> p.c;
+    return entry;
+}
 
-    return is;
+// Returns all entries in input.
+vector<Entry> parse_input(string_view input)
+{
+    vector<Entry> entries;
+    for (auto line : lines(input)) {
+        if (line.empty()) {
+            continue;
+        }
+        entries.push_back(parse_entry(line));
+    }
+    return entries;
 }
 
-int main()
+// Kinds of rule a password can be checked against, each taking the lower and
+// upper bounds and the character of its entry's policy as parameters.
+enum class RuleKind {
+    COUNT,       // the character occurs lower to upper times (part 1)
+    POSITIONS,   // exactly one of positions lower and upper holds it (part 2)
+    CLASS,       // characters of a class occur lower to upper times
+};
+
+// Rules compiled from a spec for checking passwords in one pass each.
+//
+// The spec lists rules separated by spaces:
+//
+//     count       RuleKind::COUNT
+//     positions   RuleKind::POSITIONS
+//     class:SET   RuleKind::CLASS for the characters in SET, written like the
+//                 inside of a regex bracket expression, e.g. "class:a-f0-9"
+//                 or "class:^aeiou"
+//
+// Rules are grouped by kind: every COUNT rule shares a single count of the
+// policy character and, when there are CLASS rules, the password is scanned
+// once into a histogram from which every class is counted over the distinct
+// characters of the password.
+class RuleSet {
+public:
+    // Largest number of rules in a set, one per bit of satisfied()'s result.
+    static constexpr size_t MAX_RULES = 64;
+
+    // Throws std::invalid_argument if spec is not a valid list of rules.
+    explicit RuleSet(string_view spec)
+    {
+        for (auto token : tokens(spec)) {
+            if (n_rules == MAX_RULES) {
+                throw std::invalid_argument{"more than 64 rules"};
+            }
+            auto bit = std::uint64_t{1} << n_rules;
+            if (token == "count") {
+                count_rules |= bit;
+            } else if (token == "positions") {
+                position_rules |= bit;
+            } else if (token.substr(0, 6) == "class:") {
+                class_rules.push_back({bit, parse_class(token.substr(6))});
+            } else {
+                throw std::invalid_argument{"unknown rule " + string{token}};
+            }
+            n_rules++;
+        }
+    }
+
+    size_t size() const { return n_rules; }
+
+    // Returns a mask with bit i set if entry satisfies rule i of the spec.
+    std::uint64_t satisfied(const Entry& entry) const
+    {
+        const auto& policy = entry.policy;
+        const auto& s = entry.password;
+        auto in_bounds = [&](size_t n) {
+            return policy.lower <= static_cast<long long>(n) && static_cast<long long>(n) <= policy.upper;
+        };
+
+        std::uint64_t mask = 0;
+        if (!class_rules.empty()) {
+            // classes sum the counts of just the characters that occur
+            std::array<std::uint32_t, 256> histogram{};
+            std::array<unsigned char, 256> distinct;
+            size_t n_distinct = 0;
+            for (char c : s) {
+                auto byte = static_cast<unsigned char>(c);
+                if (histogram[byte]++ == 0) {
+                    distinct[n_distinct++] = byte;
+                }
+            }
+            if (in_bounds(histogram[static_cast<unsigned char>(policy.c)])) {
+                mask |= count_rules;
+            }
+            for (const auto& rule : class_rules) {
+                size_t n = 0;
+                for (size_t i = 0; i < n_distinct; i++) {
+                    n += rule.members[distinct[i]] ? histogram[distinct[i]] : 0;
+                }
+                mask |= in_bounds(n) ? rule.bit : 0;
+            }
+        } else if (count_rules != 0 && in_bounds(count_char(s, policy.c))) {
+            mask |= count_rules;
+        }
+
+        if (position_rules != 0) {
+            auto holds = [&](int position) {
+                return 0 < position && static_cast<size_t>(position) <= s.size()
+                    && s[position - 1] == policy.c;
+            };
+            if (holds(policy.lower) != holds(policy.upper)) {
+                mask |= position_rules;
+            }
+        }
+        return mask;
+    }
+
+private:
+    struct ClassRule {
+        std::uint64_t bit;
+        std::bitset<256> members;
+    };
+
+    size_t n_rules = 0;
+    std::uint64_t count_rules = 0;      // bit i set if rule i is of the kind
+    std::uint64_t position_rules = 0;
+    vector<ClassRule> class_rules;
+
+    // Returns the characters in set, e.g. "a-z0-9" or "^aeiou".
+    static std::bitset<256> parse_class(string_view set)
+    {
+        bool negate = !set.empty() && set.front() == '^';
+        if (negate) {
+            set.remove_prefix(1);
+        }
+        if (set.empty()) {
+            throw std::invalid_argument{"empty character class"};
+        }
+        std::bitset<256> members;
+        for (size_t i = 0; i < set.size(); i++) {
+            auto first = static_cast<unsigned char>(set[i]);
+            auto last = first;
+            if (i + 2 < set.size() && set[i + 1] == '-') {
+                last = static_cast<unsigned char>(set[i + 2]);
+                i += 2;
+            }
+            if (last < first) {
+                throw std::invalid_argument{"invalid range in class " + string{set}};
+            }
+            for (auto c = first; c <= last; c++) {
+                members.set(c);
+                if (c == 255) {
+                    break;
+                }
+            }
+        }
+        return negate ? ~members : members;
+    }
+};
+
+// The rules of the puzzle: part 1's is bit 0, part 2's bit 1.
+const RuleSet PUZZLE_RULES{"count positions"};
+
+// Returns the number of entries in input that satisfy each rule in rules.
+vector<long long> count_satisfied(const RuleSet& rules, string_view input)
 {
-    ifstream data{"input.txt"};
+    vector<long long> n_satisfied(rules.size());
+    for (auto line : lines(input)) {
+        if (line.empty()) {
+            continue;
+        }
+        auto mask = rules.satisfied(parse_entry(line));
+        for (size_t i = 0; i < n_satisfied.size(); i++) {
+            n_satisfied[i] += mask >> i & 1;
+        }
+    }
+    return n_satisfied;
+}
 
-    Policy policy;
-    string s;
-    int n_valid_p1 = 0;
-    int n_valid_p2 = 0;
-
-    while (data >> policy) {
-        data.ignore(2);  // skip space and colon
-        getline(data, s);
-
-        // Part 1: ensure policy character count is within bounds
-        auto result = std::count(s.begin(), s.end(), policy.c);
-        if (policy.lower <= result && result <= policy.upper) {
-            n_valid_p1++;
+// Number of entries valid under the policy of each part.
+struct ValidCounts {
+    long long p1 = 0;
+    long long p2 = 0;
+};
+
+// Adds entry to counts, checking both policies while its password is in
+// cache.
+void count_valid(const Entry& entry, ValidCounts& counts)
+{
+    auto mask = PUZZLE_RULES.satisfied(entry);
+    counts.p1 += mask & 1;
+    counts.p2 += mask >> 1 & 1;
+}
+
+// Returns the number of entries valid under the policy of each part, checked
+// in a single pass.
+ValidCounts count_valid(const vector<Entry>& entries)
+{
+    ValidCounts counts;
+    for (const auto& entry : entries) {
+        count_valid(entry, counts);
+    }
+    return counts;
+}
+
+// Returns the number of entries in input valid under the policy of each part,
+// counted on the threads of pool.
+//
+// The input is cut at newlines into a few pieces per thread. Each piece is
+// parsed and counted straight from the input and the counts summed at the end.
+ValidCounts count_valid(string_view input, ThreadPool& pool)
+{
+    auto pieces = split_aligned(input, pool.size() * 4);
+    vector<ValidCounts> piece_counts(pieces.size());
+    pool.run(pieces.size(), [&](size_t task, size_t /* worker */) {
+        // count locally, neighbouring counts share a cache line
+        ValidCounts counts;
+        for (auto line : lines(pieces[task])) {
+            if (line.empty()) {
+                continue;
+            }
+            count_valid(parse_entry(line), counts);
         }
+        piece_counts[task] = counts;
+    });
+
+    ValidCounts total;
+    for (const auto& counts : piece_counts) {
+        total.p1 += counts.p1;
+        total.p2 += counts.p2;
+    }
+    return total;
+}
+
+void benchmark(Bench& bench, const string& filepath)
+{
+    const Input input{filepath};
+    const auto entries = bench.phase("parse", [&] { return parse_input(input.data()); });
+    ValidCounts counts;
+    bench.phase("part_1", [&] {
+        counts = count_valid(entries);
+        return counts.p1;
+    });
+    bench.phase("part_2", [&] { return counts.p2; });
+}
+
+// Solver holding the parsed entries, and the counts part 1 makes for both
+// parts, between phases.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { entries = parse_input(input); }
+
+    bool part_1(std::ostream& os) override
+    {
+        counts = count_valid(entries);
+        os << counts.p1 << " ";
+        return true;
+    }
+
+    // Requires part_1() to have counted the valid entries.
+    bool part_2(std::ostream& os) override
+    {
+        os << counts.p2 << std::endl;
+        return true;
+    }
+
+private:
+    vector<Entry> entries;
+    ValidCounts counts;
+};
 
-        // Part 2: ensure exactly one character at either lower or upper
-        // is the policy character
-        if ((s[policy.lower - 1] == policy.c && s[policy.upper - 1] != policy.c) ||
-            (s[policy.lower - 1] != policy.c && s[policy.upper - 1] == policy.c)) {
-            n_valid_p2++;
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+// Writes the answers for the input read from fd to os, holding only a chunk of
+// it in memory at a time.
+bool solve_stream(int fd, std::ostream& os)
+{
+    ValidCounts counts;
+    for_each_chunk(fd, "\n", [&](string_view chunk) {
+        for (auto line : lines(chunk)) {
+            if (line.empty()) {
+                continue;
+            }
+            count_valid(parse_entry(line), counts);
         }
+    });
+    os << counts.p1 << " " << counts.p2 << std::endl;
+    return true;
+}
+
+// Writes the number of entries in input that satisfy each rule in spec to os.
+bool solve_rules(string_view input, string_view spec, std::ostream& os)
+{
+    auto n_satisfied = count_satisfied(RuleSet{spec}, input);
+    for (size_t i = 0; i < n_satisfied.size(); i++) {
+        os << (i == 0 ? "" : " ") << n_satisfied[i];
     }
+    os << std::endl;
+    return true;
+}
+
+// Writes the answers for input to os, counted on n_threads threads.
+bool solve_parallel(string_view input, size_t n_threads, std::ostream& os)
+{
+    ThreadPool pool(n_threads);
+    auto counts = count_valid(input, pool);
+    os << counts.p1 << " " << counts.p2 << std::endl;
+    return true;
+}
+
+} // namespace day_2
 
-    std::cout << n_valid_p1 << " " << n_valid_p2 << std::endl;
+#ifndef AOC_NO_MAIN
+// Reads input.txt, or stdin when the only argument is "-". With arguments
+// --threads N, input.txt is split between N threads; build with -pthread.
+// With arguments --rules SPEC, writes the number of entries satisfying each
+// rule of a RuleSet instead.
+int main(int argc, char* argv[])
+{
+    if (argc == 2 && string_view{argv[1]} == "-") {
+        return day_2::solve_stream(0, std::cout) ? 0 : 1;
+    }
+    const Input input{"input.txt"};
+    if (argc == 3 && string_view{argv[1]} == "--rules") {
+        return day_2::solve_rules(input.data(), argv[2], std::cout) ? 0 : 1;
+    }
+    if (argc == 3 && string_view{argv[1]} == "--threads") {
+        return day_2::solve_parallel(input.data(), std::stoul(argv[2]), std::cout) ? 0 : 1;
+    }
+    return day_2::solve(input.data(), std::cout) ? 0 : 1;
 }
+#endif
@@ -1,39 +1,34 @@
 #include <cmath>
-#include <fstream>
 #include <iostream>
+#include <memory>
 #include <numeric>
-#include <regex>
 #include <set>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/solver.h"
 #include "tile.h"
 
-using std::istream;
 using std::ostream;
 using std::string;
+using std::string_view;
 using std::vector;
 
-// Returns a vector of Tile's from the file at filepath.
-vector<Tile> parse(string filepath)
-{
-    std::ifstream data{filepath};
-    if (!data) {
-        std::invalid_argument{"unable to open filepath"};
-    }
+namespace day_20 {
 
+// Returns a vector of Tile's from input.
+vector<Tile> parse(string_view input)
+{
     vector<Tile> tiles;
-
-    Tile t;
-    while (data >> t) {
-        tiles.push_back(t);
+    for (auto record : records(input)) {
+        tiles.push_back(parse_tile(record));
     }
-    if (data.eof()) {
-        tiles.push_back(t);
-    }
-
     return tiles;
 }
 
@@ -175,26 +170,19 @@ int count_not_pattern(const Tile& image, const Tile& pattern)
     return n - in_monster.size();
 }
 
-int main()
+// Returns the number of '#' not part of a sea monster in the assembled image.
+int water_roughness(const vector<Tile>& assignment)
 {
-    // Part 1
-    vector<Tile> tiles = parse("input.txt");
-    auto assignment = assemble(tiles);
-    std::cout << corner_mult(assignment) << std::endl;
-
-    // Part 2
     Tile image(assignment);
 
-    const string pattern_str = (
+    const string_view pattern_str = (
         "Tile 0:\n"
         "..................#.\n"
         "#....##....##....###\n"
         ".#..#..#..#..#..#...\n"
         "\n"
     );
-    std::stringstream ss{pattern_str};
-    Tile pattern;
-    ss >> pattern;
+    Tile pattern = parse_tile(pattern_str);
 
     // find correct orientation, rotating pattern is equivalent to rotating the
     // image
@@ -216,5 +204,58 @@ int main()
         throw std::invalid_argument{"unable to find pattern"};
     }
 
-    std::cout << count_not_pattern(image, pattern) << std::endl;
+    return count_not_pattern(image, pattern);
+}
+
+void benchmark(Bench& bench, const string& filepath)
+{
+    const Input input{filepath};
+    const auto tiles = bench.phase("parse", [&] { return parse(input.data()); });
+    const auto assignment = bench.phase("part_1", [&] { return assemble(tiles); });
+    bench.phase("part_2", [&] { return water_roughness(assignment); });
+}
+
+// Solver holding the tiles, and the assembled image that part 2 needs.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { tiles = day_20::parse(input); }
+
+    bool part_1(std::ostream& os) override
+    {
+        assignment = assemble(tiles);
+        os << corner_mult(assignment) << std::endl;
+        return true;
+    }
+
+    // Requires part_1() to have assembled the image.
+    bool part_2(std::ostream& os) override
+    {
+        os << water_roughness(assignment) << std::endl;
+        return true;
+    }
+
+private:
+    vector<Tile> tiles;
+    vector<Tile> assignment;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+} // namespace day_20
+
+#ifndef AOC_NO_MAIN
+int main()
+{
+    const Input input{"input.txt"};
+    return day_20::solve(input.data(), std::cout) ? 0 : 1;
 }
+#endif
@@ -1,11 +1,14 @@
 #include <cmath>
 #include <iostream>
-#include <regex>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "../common/input.h"
 #include "tile.h"
 
+namespace day_20 {
+
 Tile::Tile(const std::vector<Tile>& assignment, int id)
     : id{id}, orientation{N}, flip{LEFT}
 {
@@ -133,40 +136,39 @@ bool Tile::contains(const Tile& pattern)
     return false;
 }
 
-std::istream& operator>>(std::istream& is, Tile& tile)
+Tile parse_tile(std::string_view record)
 {
-    std::string line;
-    getline(is, line);
-
-    std::regex pattern("Tile ([[:digit:]]+):");
-    std::smatch matches;
-    if (!std::regex_match(line, matches, pattern)) {
-        is.clear(std::ios::failbit);
-        return is;
+    auto rows = lines(record);
+    auto line = rows.begin();
+    auto header = *line++;
+    if (header.substr(0, 5) != "Tile " || header.back() != ':') {
+        throw std::invalid_argument{"invalid tile header: " + std::string{header}};
     }
+    header.remove_prefix(5);
+    header.remove_suffix(1);
 
-    tile.id = std::stoi(matches[1].str());
-    tile.pixels.clear();
+    Tile tile;
+    tile.id = parse_int(header);
     tile.n_rows = 0;
     tile.n_cols = 0;
     tile.flip = Tile::LEFT;
     tile.orientation = Tile::N;
 
     std::vector<bool> pixels;
-    while (getline(is, line)) {
-        if (line.size() <= 1) {
+    for (; line != rows.end(); ++line) {
+        if (line->size() <= 1) {
             break;
         }
 
-        for (int i = 0; i < static_cast<int>(line.size()); i++) {
-            pixels.push_back(line[i] == '#');
+        for (int i = 0; i < static_cast<int>(line->size()); i++) {
+            pixels.push_back((*line)[i] == '#');
         }
         tile.n_rows += 1;
-        tile.n_cols = line.size();
+        tile.n_cols = line->size();
     }
     tile.pixels = pixels;
 
-    return is;
+    return tile;
 }
 
 std::ostream& operator<<(std::ostream& os, const Tile& tile)
@@ -182,3 +184,5 @@ std::ostream& operator<<(std::ostream& os, const Tile& tile)
 
     return os;
 }
+
+} // namespace day_20
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <iostream>
+#include <string_view>
 #include <vector>
 
+namespace day_20 {
+
 class Tile {
 public:
     enum Orientation {
@@ -39,6 +42,9 @@ public:
     int n_cols;
 };
 
-std::istream& operator>>(std::istream& is, Tile& tile);
+// Returns the Tile in a record of the form "Tile 1:\n#.#\n...".
+Tile parse_tile(std::string_view record);
 
 std::ostream& operator<<(std::ostream& os, const Tile& tile);
+
+} // namespace day_20
@@ -6,6 +6,8 @@
 #include <unordered_set>
 #include <vector>
 
+namespace day_21 {
+
 // undirected Edge
 //
 // equality (operator==) and hash are invariant to ordering of the vertices
@@ -21,16 +23,20 @@ struct Edge {
     }
 };
 
+} // namespace day_21
+
 namespace std {
     template<>
-    struct hash<Edge> {
-        std::size_t operator()(const Edge& e) const
+    struct hash<day_21::Edge> {
+        std::size_t operator()(const day_21::Edge& e) const
         {
             return hash<int>()(e.first) ^ hash<int>()(e.second);
         }
     };
 }
 
+namespace day_21 {
+
 class Graph {
 public:
     using Matching = std::unordered_set<Edge>;
@@ -144,3 +150,5 @@ public:
 private:
     std::vector<std::list<int>> adj;
 };
+
+} // namespace day_21
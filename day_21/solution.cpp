@@ -1,67 +1,58 @@
-#include <fstream>
+#include <algorithm>
 #include <iostream>
-#include <iterator>
-#include <regex>
-#include <sstream>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/solver.h"
 #include "graph.h"
 
 using std::string;
+using std::string_view;
 using std::unordered_map;
 using std::unordered_set;
 using std::unordered_multiset;
 
-using Ingredient = string;
-using Allergy = string;
+namespace day_21 {
+
+using Ingredient = string_view;
+using Allergy = string_view;
 using AllergyMap = unordered_map<Allergy, unordered_set<Ingredient>>;
 using IngredientCount = unordered_multiset<Ingredient>;
+using Food = std::pair<AllergyMap, IngredientCount>;
 
-std::pair<AllergyMap, IngredientCount> parse_input(string filepath)
+// Returns the allergy map and ingredient counts for the foods in input.
+//
+// Each line is of the form "ingredient ingredient (contains allergy, allergy)".
+Food parse_input(string_view input)
 {
-    std::ifstream data{filepath};
-    if (!data) {
-        throw std::invalid_argument{"unable to open " + filepath};
-    }
+    constexpr string_view CONTAINS = " (contains ";
 
     AllergyMap allergy_map;
     IngredientCount ingredient_counts;
 
-    std::regex pattern{
-        "([[:alpha:]]+(?: [[:alpha:]]+)*)"
-        " \\(contains ([[:alpha:]]+(?:, [[:alpha:]]+)*)\\)"
-    };
-    std::smatch matches;
-
-    string line;
-    while (getline(data, line)) {
-        if (!std::regex_match(line, matches, pattern)) {
-            throw std::invalid_argument{"invalid input: " + line};
-        }
-        if (!matches[2].matched) {
-            // no allergy restrictions
-            continue;
+    for (auto line : lines(input)) {
+        auto contains = line.find(CONTAINS);
+        if (contains == line.npos || line.back() != ')') {
+            throw std::invalid_argument{"invalid input: " + string{line}};
         }
         // parse ingredients into vector
         unordered_set<Ingredient> ingredients;
-        std::stringstream items{matches[1]};
-        string item;
-        while (items >> item) {
+        for (auto item : tokens(line.substr(0, contains), " ")) {
             ingredients.insert(item);
             ingredient_counts.insert(item);
         }
 
-        std::stringstream allergies{matches[2].str()};
-        Allergy allergy;
-        while (allergies >> allergy) {
-            if (allergy.back() == ',') {
-                allergy.pop_back();
-            }
-
+        auto allergies = line.substr(contains + CONTAINS.size());
+        allergies.remove_suffix(1);
+        for (auto allergy : tokens(allergies, ", ")) {
             if (allergy_map.find(allergy) == allergy_map.end()) {
                 // new allergy, add all ingredients
                 allergy_map[allergy] = ingredients;
@@ -83,38 +74,47 @@ std::pair<AllergyMap, IngredientCount> parse_input(string filepath)
     return {allergy_map, ingredient_counts};
 }
 
-int main()
+// Returns all ingredients that cannot contain any allergy.
+unordered_set<Ingredient> allergy_free_ingredients(const Food& result)
 {
-    auto result = parse_input("input.txt");
-
-    unordered_set<Ingredient> ingredients {
+    unordered_set<Ingredient> allergy_free {
         result.second.begin(),
         result.second.end()
     };
-
-    // Part 1
-    unordered_set<Ingredient> allergy_free{ingredients};
     for (auto& entry : result.first) {
         for (auto& ingredient : entry.second) {
             allergy_free.erase(ingredient);
         }
     }
+    return allergy_free;
+}
 
+// Part 1: Returns the number of times allergy free ingredients appear.
+int count_allergy_free(const Food& result)
+{
     int count = 0;
-    for (auto& entry : allergy_free) {
+    for (auto& entry : allergy_free_ingredients(result)) {
         count += result.second.count(entry);
     }
+    return count;
+}
 
-    std::cout << count << std::endl;
+// Part 2: Returns the canonical dangerous ingredient list.
+string dangerous_ingredients(const Food& result)
+{
+    unordered_set<Ingredient> ingredients {
+        result.second.begin(),
+        result.second.end()
+    };
+    auto allergy_free = allergy_free_ingredients(result);
 
-    // Part 2
     // construct bipartite graph between ingredients and allergies
 
     // assign unique ID to all ingredients and allergies
     //
     // convenience maps to convert to/from int and string representations
-    unordered_map<string, int> string_index;
-    unordered_map<int, string> index_string;
+    unordered_map<string_view, int> string_index;
+    unordered_map<int, string_view> index_string;
     int n = 0;   // index of next vertex to add
     // assign all ingredients that might contain allergies an index
     for (auto& ingredient : ingredients) {
@@ -148,7 +148,7 @@ int main()
     auto matching = g.matching();
 
     // create vector of <allergy, ingredient>
-    std::vector<std::pair<string, string>> matching_str;
+    std::vector<std::pair<string_view, string_view>> matching_str;
     for (auto &edge : matching) {
         matching_str.push_back(
             {index_string[edge.second], index_string[edge.first]}
@@ -159,8 +159,61 @@ int main()
     std::sort(matching_str.begin(), matching_str.end());
 
     // output
+    string dangerous;
     for (auto it = matching_str.begin(); it + 1 != matching_str.end(); it++) {
-        std::cout << it->second << ",";
+        dangerous += it->second;
+        dangerous += ",";
     }
-    std::cout << matching_str.back().second << std::endl;
+    dangerous += matching_str.back().second;
+    return dangerous;
+}
+
+void benchmark(Bench& bench, const string& filepath)
+{
+    const Input input{filepath};
+    const auto result = bench.phase("parse", [&] { return parse_input(input.data()); });
+    bench.phase("part_1", [&] { return count_allergy_free(result); });
+    bench.phase("part_2", [&] { return dangerous_ingredients(result); });
+}
+
+// Solver holding the parsed foods between phases.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { food = parse_input(input); }
+
+    bool part_1(std::ostream& os) override
+    {
+        os << count_allergy_free(food) << std::endl;
+        return true;
+    }
+
+    bool part_2(std::ostream& os) override
+    {
+        os << dangerous_ingredients(food) << std::endl;
+        return true;
+    }
+
+private:
+    Food food;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+} // namespace day_21
+
+#ifndef AOC_NO_MAIN
+int main()
+{
+    const Input input{"input.txt"};
+    return day_21::solve(input.data(), std::cout) ? 0 : 1;
 }
+#endif
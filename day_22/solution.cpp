@@ -1,26 +1,40 @@
 #include <algorithm>
 #include <deque>
-#include <regex>
-#include <fstream>
 #include <unordered_set>
 #include <memory>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/solver.h"
 
 using std::deque;
-using std::istream;
 using std::ostream;
+using std::string;
+using std::string_view;
 using std::unordered_set;
 
+namespace day_22 {
+
 using Card = int;
 
 class Player;
+
+} // namespace day_22
+
 namespace std {
     template<>
-    struct hash<Player> {
-        std::size_t operator()(const Player& player) const noexcept;
+    struct hash<day_22::Player> {
+        std::size_t operator()(const day_22::Player& player) const noexcept;
     };
 }
 
+namespace day_22 {
+
 class Player {
 public:
     Player() {}
@@ -50,7 +64,7 @@ public:
         return p1.id == p2.id && p1.deck == p2.deck;
     }
 
-    friend istream& operator>>(istream& is, Player& player);
+    friend Player parse_player(string_view record);
     friend ostream& operator<<(ostream& os, const Player& player);
     friend size_t std::hash<Player>::operator()(const Player&) const noexcept;
 
@@ -59,8 +73,10 @@ private:
     int id;
 };
 
+} // namespace day_22
+
 namespace std {
-    std::size_t hash<Player>::operator()(const Player& player) const noexcept
+    std::size_t hash<day_22::Player>::operator()(const day_22::Player& player) const noexcept
     {
         std::size_t seed = player.get_id() ^ player.size();
         for (auto i : player.deck) {
@@ -70,36 +86,39 @@ namespace std {
     }
 
     template<>
-    struct hash<std::pair<Player, Player>> {
-        std::size_t operator()(const std::pair<Player, Player>& players) const noexcept
+    struct hash<std::pair<day_22::Player, day_22::Player>> {
+        std::size_t operator()(
+            const std::pair<day_22::Player, day_22::Player>& players
+        ) const noexcept
         {
-            auto h = std::hash<Player>{};
+            auto h = std::hash<day_22::Player>{};
             return h(players.first) ^ h(players.second);
         }
     };
 };
 
-istream& operator>>(istream& is, Player& player)
+namespace day_22 {
+
+// Returns the Player in a record of the form "Player 1:\n9\n2\n...".
+Player parse_player(string_view record)
 {
-    is >> std::ws;
-    std::smatch matches;
-    std::string line;
-
-    if (getline(is, line)) {
-        if (!std::regex_match(line, matches, std::regex("^Player ([[:digit:]]+):$"))) {
-            is.clear(std::ios::failbit);
-            return is;
-        }
-        player.id = std::stoi(matches[1].str());
+    auto rows = lines(record);
+    auto line = rows.begin();
+    auto header = *line++;
+    if (header.substr(0, 7) != "Player " || header.back() != ':') {
+        throw std::invalid_argument{"invalid player header: " + string{header}};
     }
+    header.remove_prefix(7);
+    header.remove_suffix(1);
 
-    int card;
-    while (is >> card) {
-        player.deck.push_back(card);
+    Player player;
+    player.id = parse_int(header);
+
+    for (; line != rows.end(); ++line) {
+        player.deck.push_back(parse_int(*line));
     }
-    is.clear();
 
-    return is;
+    return player;
 }
 
 ostream& operator<<(ostream& os, const Player& player)
@@ -208,21 +227,62 @@ int recursive_combat(std::pair<Player, Player> players)
     return score;
 }
 
-int main()
+// Returns the two players in input.
+std::pair<Player, Player> parse_input(string_view input)
 {
-    std::ifstream data{"input.txt"};
+    auto players = records(input);
+    if (players.size() != 2) {
+        throw std::invalid_argument{"expected two players"};
+    }
+    return {parse_player(players[0]), parse_player(players[1])};
+}
 
-    Player p1;
-    data >> p1;
+void benchmark(Bench& bench, const string& filepath)
+{
+    const Input input{filepath};
+    const auto players = bench.phase("parse", [&] { return parse_input(input.data()); });
+    bench.phase("part_1", [&] { return combat(players.first, players.second); });
+    bench.phase("part_2", [&] { return recursive_combat(players); });
+}
 
-    Player p2;
-    data >> p2;
+// Solver holding the starting decks between phases.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { players = parse_input(input); }
 
-    // Part 1
-    std::cout << combat(p1, p2) << std::endl;
+    bool part_1(std::ostream& os) override
+    {
+        os << combat(players.first, players.second) << std::endl;
+        return true;
+    }
+
+    bool part_2(std::ostream& os) override
+    {
+        os << recursive_combat(players) << std::endl;
+        return true;
+    }
 
-    // Part 2
-    std::pair<Player, Player> players = {p1, p2};
-    std::cout << recursive_combat(players) << std::endl;
+private:
+    std::pair<Player, Player> players;
+};
 
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+} // namespace day_22
+
+#ifndef AOC_NO_MAIN
+int main()
+{
+    const Input input{"input.txt"};
+    return day_22::solve(input.data(), std::cout) ? 0 : 1;
 }
+#endif
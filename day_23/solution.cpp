@@ -1,12 +1,21 @@
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <list>
+#include <memory>
 #include <numeric>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
+#include "../common/bench.h"
+#include "../common/solver.h"
+
+namespace day_23 {
+
 class Cups {
 public:
     Cups(std::initializer_list<int> c)
@@ -108,24 +117,125 @@ private:
     std::list<int>::iterator current;
 };
 
-int main()
+// Part 1: Returns the labels on the cups after cup 1 after 100 moves.
+std::string labels_after_1(std::initializer_list<int> labels)
 {
-    // Part 1
-    Cups cups({4, 6, 7, 5, 2, 8, 1, 9, 3});
+    Cups cups(labels);
     for (int i = 0; i < 100; i++) {
         cups.move();
     }
-    std::cout << cups.after_cup(1) << std::endl;
+    return cups.after_cup(1);
+}
 
-    // Part 2
-    Cups cups_2({4, 6, 7, 5, 2, 8, 1, 9, 3});
-    cups_2.append_to(1'000'000);
+// Part 2: Returns the multiple of the two cups after cup 1 after 10 million
+// moves with one million cups.
+long long mult_after_1(std::initializer_list<int> labels)
+{
+    Cups cups(labels);
+    cups.append_to(1'000'000);
     for (int i = 0; i < 10'000'000; i++) {
-        cups_2.move();
+        cups.move();
     }
-    auto after_1 = cups_2.after_n(2, 1);
-    long long result = std::accumulate(
+    auto after_1 = cups.after_n(2, 1);
+    return std::accumulate(
         after_1.begin(), after_1.end(), 1ll, std::multiplies<long long>()
     );
-    std::cout << result << std::endl;
 }
+
+namespace compile_time {
+
+// Returns the labels on the cups after cup 1 after n_moves, read as a number,
+// for cups labelled 1 to N.
+//
+// Stores the circle as the label clockwise of each label, so a move only
+// relinks three cups.
+template <std::size_t N>
+constexpr long long labels_after_1(const std::array<int, N>& labels, int n_moves)
+{
+    std::array<int, N + 1> next{};
+    for (std::size_t i = 0; i < N; i++) {
+        next[labels[i]] = labels[(i + 1) % N];
+    }
+
+    int current = labels[0];
+    for (int i = 0; i < n_moves; i++) {
+        int first = next[current];
+        int second = next[first];
+        int third = next[second];
+        next[current] = next[third];
+
+        int dest = current;
+        do {
+            dest = dest == 1 ? N : dest - 1;
+        } while (dest == first || dest == second || dest == third);
+
+        next[third] = next[dest];
+        next[dest] = first;
+        current = next[current];
+    }
+
+    long long result = 0;
+    for (int cup = next[1]; cup != 1; cup = next[cup]) {
+        result = result * 10 + cup;
+    }
+    return result;
+}
+
+} // namespace compile_time
+
+#ifdef AOC_EMBED_INPUT
+// Part 2's ten million moves are far beyond the compiler's evaluation limits.
+constexpr auto EMBEDDED_PART_1 =
+    compile_time::labels_after_1<9>({4, 6, 7, 5, 2, 8, 1, 9, 3}, 100);
+#endif
+
+// The puzzle input has no file, filepath is unused.
+void benchmark(Bench& bench, const std::string& /* filepath */)
+{
+    bench.phase("part_1", [] { return labels_after_1({4, 6, 7, 5, 2, 8, 1, 9, 3}); });
+    bench.phase("part_2", [] { return mult_after_1({4, 6, 7, 5, 2, 8, 1, 9, 3}); });
+}
+
+// Solver for the fixed puzzle input; there is nothing to parse.
+class Solution : public Solver {
+public:
+    void parse(std::string_view /* input */) override { }
+
+    bool part_1(std::ostream& os) override
+    {
+        os << labels_after_1({4, 6, 7, 5, 2, 8, 1, 9, 3}) << std::endl;
+        return true;
+    }
+
+    bool part_2(std::ostream& os) override
+    {
+        os << mult_after_1({4, 6, 7, 5, 2, 8, 1, 9, 3}) << std::endl;
+        return true;
+    }
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers to os, the puzzle input has no file so input is unused.
+bool solve(std::string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+} // namespace day_23
+
+#ifndef AOC_NO_MAIN
+int main()
+{
+#ifdef AOC_EMBED_INPUT
+    // Part 1 was found by the compiler.
+    std::cout << day_23::EMBEDDED_PART_1 << std::endl;
+    return day_23::Solution{}.part_2(std::cout) ? 0 : 1;
+#else
+    return day_23::solve({}, std::cout) ? 0 : 1;
+#endif
+}
+#endif
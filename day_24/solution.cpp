@@ -1,14 +1,23 @@
-#include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/solver.h"
+#include "../common/stream.h"
+
 using std::string;
+using std::string_view;
 using std::unordered_set;
 using std::vector;
 
+namespace day_24 {
+
 // Axial (trapezoidal/oblique/skewed) coordinate system.
 //
 // The cube coordinate system takes a diagonal plane out of a 3D cube where the
@@ -72,10 +81,12 @@ private:
     int row;
 };
 
+} // namespace day_24
+
 namespace std {
     template <>
-    struct hash<Coordinate> {
-        std::size_t operator()(const Coordinate& c) const
+    struct hash<day_24::Coordinate> {
+        std::size_t operator()(const day_24::Coordinate& c) const
         {
             // implementation from boost::hash_combine
             //
@@ -88,8 +99,10 @@ namespace std {
     };
 }
 
+namespace day_24 {
+
 // Returns all directions in the given string - assumes input is valid.
-vector<Coordinate::Direction> parse_directions(const string& directions)
+vector<Coordinate::Direction> parse_directions(string_view directions)
 {
     vector<Coordinate::Direction> result;
 
@@ -121,19 +134,23 @@ vector<Coordinate::Direction> parse_directions(const string& directions)
     return result;
 }
 
-// Returns the coordinates of black tiles after executing all flips in filepath.
-unordered_set<Coordinate> get_black_tiles(string filepath)
+// Returns the directions to each tile to flip in input.
+vector<vector<Coordinate::Direction>> parse_input(string_view input)
 {
-    std::ifstream data{filepath};
-    if (!data) {
-        throw std::invalid_argument{"unable to open " + filepath};
+    vector<vector<Coordinate::Direction>> flips;
+    for (auto line : lines(input)) {
+        flips.push_back(parse_directions(line));
     }
 
-    unordered_set<Coordinate> black_tiles;
-    string line;
-    while (getline(data, line)) {
-        auto directions = parse_directions(line);
+    return flips;
+}
 
+// Executes all flips on the black tiles in black_tiles.
+void flip_tiles(
+    const vector<vector<Coordinate::Direction>>& flips,
+    unordered_set<Coordinate>& black_tiles
+) {
+    for (const auto& directions : flips) {
         Coordinate c;
         for (auto d : directions) {
             c.move(d);
@@ -148,7 +165,14 @@ unordered_set<Coordinate> get_black_tiles(string filepath)
             black_tiles.insert(c);
         }
     }
+}
 
+// Returns the coordinates of black tiles after executing all flips.
+unordered_set<Coordinate> get_black_tiles(
+    const vector<vector<Coordinate::Direction>>& flips
+) {
+    unordered_set<Coordinate> black_tiles;
+    flip_tiles(flips, black_tiles);
     return black_tiles;
 }
 
@@ -198,16 +222,84 @@ unordered_set<Coordinate> update_tiles(unordered_set<Coordinate> black_tiles)
     return new_tiles;
 }
 
-int main()
+// Returns the number of black tiles after n_days of updates.
+size_t n_black_after(unordered_set<Coordinate> black_tiles, int n_days)
+{
+    for (int day = 0; day < n_days; day++) {
+        black_tiles = update_tiles(black_tiles);
+    }
+    return black_tiles.size();
+}
+
+void benchmark(Bench& bench, const string& filepath)
+{
+    const Input input{filepath};
+    const auto flips = bench.phase("parse", [&] { return parse_input(input.data()); });
+    const auto black_tiles = bench.phase("part_1", [&] { return get_black_tiles(flips); });
+    bench.phase("part_2", [&] { return n_black_after(black_tiles, 100); });
+}
+
+// Solver holding the flips, and the tiles part 1 turns black for part 2.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { flips = parse_input(input); }
+
+    bool part_1(std::ostream& os) override
+    {
+        black_tiles = get_black_tiles(flips);
+        os << black_tiles.size() << std::endl;
+        return true;
+    }
+
+    // Requires part_1() to have flipped the initial tiles.
+    bool part_2(std::ostream& os) override
+    {
+        const int N_DAYS = 100;
+        os << n_black_after(black_tiles, N_DAYS) << std::endl;
+        return true;
+    }
+
+private:
+    vector<vector<Coordinate::Direction>> flips;
+    unordered_set<Coordinate> black_tiles;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
 {
-    // Part 1
-    auto black_tiles = get_black_tiles("input.txt");
-    std::cout << black_tiles.size() << std::endl;
+    return Solution{}.solve(input, os);
+}
+
+// Writes the answers for the input read from fd to os, holding only a chunk of
+// it, and the black tiles, in memory at a time.
+bool solve_stream(int fd, std::ostream& os)
+{
+    unordered_set<Coordinate> black_tiles;
+    for_each_chunk(fd, "\n", [&](string_view chunk) {
+        flip_tiles(parse_input(chunk), black_tiles);
+    });
+    os << black_tiles.size() << std::endl;
 
-    // Part 2
     const int N_DAYS = 100;
-    for (int day = 0; day < N_DAYS; day++) {
-        black_tiles = update_tiles(black_tiles);
+    os << n_black_after(black_tiles, N_DAYS) << std::endl;
+    return true;
+}
+
+} // namespace day_24
+
+#ifndef AOC_NO_MAIN
+// Reads input.txt, or stdin when the only argument is "-".
+int main(int argc, char* argv[])
+{
+    if (argc == 2 && string_view{argv[1]} == "-") {
+        return day_24::solve_stream(0, std::cout) ? 0 : 1;
     }
-    std::cout << black_tiles.size() << std::endl;
+    const Input input{"input.txt"};
+    return day_24::solve(input.data(), std::cout) ? 0 : 1;
 }
+#endif
@@ -1,6 +1,18 @@
-#include <fstream>
+#include <array>
+#include <cstddef>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
+
+#include "../common/bench.h"
+#include "../common/embed.h"
+#include "../common/input.h"
+#include "../common/solver.h"
+
+namespace day_25 {
 
 long transform(long loop_size, long subject_number, long mod = 20201227)
 {
@@ -23,34 +35,163 @@ long recover_loop_size(long public_key, long subject_number = 7, long mod = 2020
     return ls;
 }
 
-std::pair<long, long> read_keys(std::string filepath)
+std::pair<long, long> read_keys(std::string_view input)
 {
-    std::ifstream data{filepath};
-    if (!data) {
-        throw std::invalid_argument{"unable to open file"};
-    }
-
     std::pair<long, long> keys;
 
-    std::string line;
-    getline(data, line);
-    keys.first = std::stol(line);
+    auto rows = lines(input);
+    auto line = rows.begin();
+    if (line == rows.end()) {
+        throw std::invalid_argument{"missing card public key"};
+    }
+    keys.first = parse_int<long>(*line++);
 
-    getline(data, line);
-    keys.second = std::stol(line);
+    if (line == rows.end()) {
+        throw std::invalid_argument{"missing door public key"};
+    }
+    keys.second = parse_int<long>(*line);
 
     return keys;
 }
 
-int main()
+// Returns the encryption key the card and door use to communicate.
+long encryption_key(std::pair<long, long> keys)
 {
-    auto keys = read_keys("input.txt");
-
     long card_pk = keys.first;
     long door_pk = keys.second;
 
     auto card_ls = recover_loop_size(card_pk);
-    auto enc_key = transform(card_ls, door_pk);
+    return transform(card_ls, door_pk);
+}
+
+namespace compile_time {
+
+constexpr long MOD = 20201227;
+
+// Returns base^exp modulo MOD.
+constexpr long pow_mod(long long base, long exp)
+{
+    long long result = 1;
+    base %= MOD;
+    for (; exp > 0; exp >>= 1) {
+        if (exp & 1) {
+            result = result * base % MOD;
+        }
+        base = base * base % MOD;
+    }
+    return result;
+}
+
+// Returns the loop size that transforms 7 into public_key.
+//
+// recover_loop_size() may take millions of steps, too many for the compiler,
+// so this uses baby-step giant-step instead: with M = ceil(sqrt(MOD)) the
+// loop size is i * M + j for j < M where 7^j = public_key * 7^(-i * M). A
+// table of 7^j is built once and then searched for at most M values of i.
+constexpr long recover_loop_size(long public_key)
+{
+    constexpr long M = 4495;
+    constexpr std::size_t TABLE_SIZE = 1 << 13;
+
+    // open-addressed table of 7^j -> j; no power of 7 is 0 modulo a prime
+    std::array<long, TABLE_SIZE> powers{};
+    std::array<long, TABLE_SIZE> exponents{};
+    auto slot_of = [&](long power) {
+        auto slot = static_cast<std::size_t>(power) % TABLE_SIZE;
+        while (powers[slot] != 0 && powers[slot] != power) {
+            slot = (slot + 1) % TABLE_SIZE;
+        }
+        return slot;
+    };
 
-    std::cout << enc_key << std::endl;
+    long long power = 1;
+    for (long j = 0; j < M; j++) {
+        auto slot = slot_of(power);
+        if (powers[slot] == 0) {   // keep the smallest exponent
+            powers[slot] = power;
+            exponents[slot] = j;
+        }
+        power = power * 7 % MOD;
+    }
+
+    // 7^(MOD - 1) = 1, so 7^(-M) = 7^(MOD - 1 - M)
+    const long long step = pow_mod(7, MOD - 1 - M);
+    long long target = public_key;
+    for (long i = 0; i < M; i++) {
+        auto slot = slot_of(target);
+        if (powers[slot] == target) {
+            return i * M + exponents[slot];
+        }
+        target = target * step % MOD;
+    }
+    throw std::invalid_argument{"no loop size gives the public key"};
+}
+
+// Returns the encryption key the card and door use to communicate.
+constexpr long encryption_key(std::string_view input)
+{
+    auto keys = parse_ints<long, 2>(lines(input));
+    return pow_mod(keys[1], recover_loop_size(keys[0]));
+}
+
+} // namespace compile_time
+
+#ifdef AOC_EMBED_INPUT
+// The puzzle input compiled into the program, see common/embed.h.
+constexpr std::string_view EMBEDDED_INPUT =
+#include "input.inc"
+    ;
+
+constexpr auto EMBEDDED_PART_1 = compile_time::encryption_key(EMBEDDED_INPUT);
+#endif
+
+void benchmark(Bench& bench, const std::string& filepath)
+{
+    const Input input{filepath};
+    const auto keys = bench.phase("parse", [&] { return read_keys(input.data()); });
+    bench.phase("part_1", [&] { return encryption_key(keys); });
+}
+
+// Solver holding the public keys; the last day has no second part.
+class Solution : public Solver {
+public:
+    void parse(std::string_view input) override { keys = read_keys(input); }
+
+    bool part_1(std::ostream& os) override
+    {
+        os << encryption_key(keys) << std::endl;
+        return true;
+    }
+
+    bool part_2(std::ostream& /* os */) override { return true; }
+
+private:
+    std::pair<long, long> keys;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(std::string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+} // namespace day_25
+
+#ifndef AOC_NO_MAIN
+int main()
+{
+#ifdef AOC_EMBED_INPUT
+    // The only answer was found by the compiler.
+    std::cout << day_25::EMBEDDED_PART_1 << std::endl;
+    return 0;
+#else
+    const Input input{"input.txt"};
+    return day_25::solve(input.data(), std::cout) ? 0 : 1;
+#endif
 }
+#endif
@@ -1,44 +1,307 @@
-#include <fstream>
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <numeric>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
-using std::getline;
-using std::ifstream;
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/solver.h"
+#include "../common/stream.h"
+#include "../common/thread_pool.h"
+
 using std::pair;
 using std::string;
+using std::string_view;
 using std::vector;
 
-int main()
+namespace day_3 {
+
+// right X, down Y: {X, Y}
+using Slope = pair<int, int>;
+
+const vector<Slope> SLOPES = {{1, 1}, {3, 1}, {5, 1}, {7, 1}, {1, 2}};
+
+// The map with each row packed into 64-bit words, bit j of a row set if
+// there is a tree in column j.
+struct TreeMap {
+    size_t width = 0;
+    size_t height = 0;
+    size_t words_per_row = 0;
+    vector<std::uint64_t> words;
+
+    // Returns true if there is a tree at column, which is less than width, of
+    // row.
+    bool tree(size_t row, size_t column) const
+    {
+        return words[row * words_per_row + column / 64] >> (column % 64) & 1;
+    }
+};
+
+// Returns the map in input, skipping blank lines.
+//
+// Throws std::invalid_argument if its rows differ in width.
+TreeMap parse_input(string_view input)
 {
-    ifstream data{"input.txt"};
+    TreeMap map;
+    for (auto line : lines(input)) {
+        if (line.empty()) {
+            continue;
+        }
+        if (map.height == 0) {
+            map.width = line.size();
+            map.words_per_row = (map.width + 63) / 64;
+        } else if (line.size() != map.width) {
+            throw std::invalid_argument{"rows of different widths"};
+        }
+        map.words.resize(map.words.size() + map.words_per_row);
+        auto row = map.words.end() - map.words_per_row;
+        for (size_t column = 0; column < line.size(); column++) {
+            row[column / 64] |= std::uint64_t{line[column] == '#'} << (column % 64);
+        }
+        map.height++;
+    }
+    return map;
+}
 
-    // right X, down Y: {X, Y}
-    vector<pair<int, int>> slopes = {{1, 1}, {3, 1}, {5, 1}, {7, 1}, {1, 2}};
+// Rows of the map each slope is walked over before moving on to the next rows,
+// so a batch of slopes reads each block of rows from memory once.
+constexpr size_t ROW_BLOCK = 4096;
+
+// Returns the number of trees encountered for each slope in rows [begin, end)
+// of the map, where the map starts at row first_row of the whole map.
+//
+// Each slope starts at the column it reaches by its first row in the range,
+// so ranges can be counted separately and their counts summed. Only the rows
+// each slope lands on are visited, and its column is kept within the width by
+// adding its step rather than taking a modulus.
+//
+// Throws std::invalid_argument if a slope does not move down.
+vector<unsigned int> count_trees(
+    const TreeMap& map,
+    const vector<Slope>& slopes,
+    size_t begin,
+    size_t end,
+    unsigned long long first_row = 0
+)
+{
     vector<unsigned int> n_trees(slopes.size());
-    unsigned int line_no = 0;
-    string line;
-
-    while (getline(data, line)) {
-        for (typename decltype(slopes)::size_type i = 0; i < slopes.size(); i++) {
-            auto &slope = slopes[i];
-            if (line_no % slope.second != 0) {
-                // skip until moved down by Y
-                continue;
+    end = std::min(end, map.height);
+    if (map.width == 0 || begin >= end) {
+        return n_trees;
+    }
+
+    // position of a slope's next visit, its row relative to the map
+    struct Walk {
+        size_t row;
+        size_t column;
+        size_t step;   // columns moved right per visit, modulo the width
+        size_t down;
+    };
+    vector<Walk> walks;
+    for (const auto& slope : slopes) {
+        if (slope.second <= 0) {
+            throw std::invalid_argument{"slope must move down"};
+        }
+        auto width = static_cast<long long>(map.width);
+        size_t step = (slope.first % width + width) % width;
+        size_t down = slope.second;
+        // the first row at or after begin that the slope lands on
+        auto start = first_row + begin;
+        auto n_visits = (start + down - 1) / down;
+        size_t row = n_visits * down - first_row;
+        size_t column = step * (n_visits % map.width) % map.width;
+        walks.push_back({row, column, step, down});
+    }
+
+    for (auto block_end = begin + ROW_BLOCK; ; block_end += ROW_BLOCK) {
+        auto stop = std::min(block_end, end);
+        for (size_t i = 0; i < walks.size(); i++) {
+            auto& walk = walks[i];
+            auto n = n_trees[i];
+            for (; walk.row < stop; walk.row += walk.down) {
+                n += map.tree(walk.row, walk.column);
+                walk.column += walk.step;
+                if (walk.column >= map.width) {
+                    walk.column -= map.width;
+                }
             }
-            // current pos is X times the number of downward steps, tree patten
-            // repeats so take modulus
-            auto pos = (slope.first * (line_no / slope.second)) % line.size();
-            n_trees[i] += line[pos] == '#';
+            n_trees[i] = n;
+        }
+        if (stop == end) {
+            break;
         }
-        line_no++;
     }
 
-    auto total = std::accumulate(
+    return n_trees;
+}
+
+// Returns the number of trees encountered for each slope, where the map starts
+// at row first_row of the whole map.
+vector<unsigned int> count_trees(
+    const TreeMap& map, const vector<Slope>& slopes, unsigned long long first_row = 0
+)
+{
+    return count_trees(map, slopes, 0, map.height, first_row);
+}
+
+// Returns the number of trees encountered for each slope, counted on the
+// threads of pool.
+//
+// The rows are split into a few bands per thread. Each band starts its walks at
+// the first row where each slope lands in it, and the bands' counts are summed.
+vector<unsigned int> count_trees(const TreeMap& map, const vector<Slope>& slopes, ThreadPool& pool)
+{
+    const auto n_bands = pool.size() * 4;
+    const auto band = (map.height + n_bands - 1) / n_bands;
+    vector<vector<unsigned int>> band_trees(n_bands);
+    pool.run(n_bands, [&](size_t task, size_t /* worker */) {
+        band_trees[task] = count_trees(map, slopes, task * band, (task + 1) * band);
+    });
+
+    vector<unsigned int> n_trees(slopes.size());
+    for (const auto& trees : band_trees) {
+        for (size_t i = 0; i < n_trees.size(); i++) {
+            n_trees[i] += trees[i];
+        }
+    }
+    return n_trees;
+}
+
+// Returns the product of the number of trees encountered for each slope.
+unsigned int mult_trees(const vector<unsigned int>& n_trees)
+{
+    return std::accumulate(
         n_trees.begin(), n_trees.end(), 1u, std::multiplies<unsigned int>()
     );
-    std::cout << n_trees[1] << " " << total << std::endl;
 }
+
+void benchmark(Bench& bench, const string& filepath)
+{
+    const Input input{filepath};
+    const auto map = bench.phase("parse", [&] { return parse_input(input.data()); });
+    bench.phase("part_1", [&] { return count_trees(map, {{3, 1}}); });
+    bench.phase("part_2", [&] { return mult_trees(count_trees(map, SLOPES)); });
+}
+
+// Solver holding the parsed map between phases.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { map = parse_input(input); }
+
+    bool part_1(std::ostream& os) override
+    {
+        os << count_trees(map, {{3, 1}})[0] << " ";
+        return true;
+    }
+
+    bool part_2(std::ostream& os) override
+    {
+        os << mult_trees(count_trees(map, SLOPES)) << std::endl;
+        return true;
+    }
+
+private:
+    TreeMap map;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+// Writes the answers for the input read from fd to os, holding only a chunk of
+// it in memory at a time.
+bool solve_stream(int fd, std::ostream& os)
+{
+    // SLOPES includes the part 1 slope, so one pass counts both parts
+    vector<unsigned int> n_trees(SLOPES.size());
+    unsigned int n_rows = 0;
+    for_each_chunk(fd, "\n", [&](string_view chunk) {
+        auto map = parse_input(chunk);
+        auto chunk_trees = count_trees(map, SLOPES, n_rows);
+        for (size_t i = 0; i < n_trees.size(); i++) {
+            n_trees[i] += chunk_trees[i];
+        }
+        n_rows += map.height;
+    });
+    os << n_trees[1] << " " << mult_trees(n_trees) << std::endl;
+    return true;
+}
+
+// Writes the answers for input to os, counted on n_threads threads.
+bool solve_parallel(string_view input, size_t n_threads, std::ostream& os)
+{
+    ThreadPool pool(n_threads);
+    // SLOPES includes the part 1 slope, so one pass counts both parts
+    auto n_trees = count_trees(parse_input(input), SLOPES, pool);
+    os << n_trees[1] << " " << mult_trees(n_trees) << std::endl;
+    return true;
+}
+
+// Writes the number of trees encountered on each slope in slopes, given as
+// "right,down", to os, counted on n_threads threads.
+bool solve_slopes(
+    string_view input, const vector<string_view>& slopes, size_t n_threads, std::ostream& os
+)
+{
+    vector<Slope> queries;
+    for (auto slope : slopes) {
+        auto right = consume_int(slope);
+        if (slope.empty() || slope.front() != ',') {
+            throw std::invalid_argument{"expected right,down"};
+        }
+        slope.remove_prefix(1);
+        queries.emplace_back(right, parse_int(slope));
+    }
+
+    ThreadPool pool(n_threads);
+    auto n_trees = count_trees(parse_input(input), queries, pool);
+    for (size_t i = 0; i < n_trees.size(); i++) {
+        os << (i == 0 ? "" : " ") << n_trees[i];
+    }
+    os << std::endl;
+    return true;
+}
+
+} // namespace day_3
+
+#ifndef AOC_NO_MAIN
+// Reads input.txt, or stdin when the only argument is "-". Arguments of the
+// form right,down instead write the number of trees on each of those slopes.
+// Leading arguments --threads N split the rows between N threads; build with
+// -pthread.
+int main(int argc, char* argv[])
+{
+    if (argc == 2 && string_view{argv[1]} == "-") {
+        return day_3::solve_stream(0, std::cout) ? 0 : 1;
+    }
+    const Input input{"input.txt"};
+    size_t n_threads = 1;
+    int first_slope = 1;
+    if (argc >= 3 && string_view{argv[1]} == "--threads") {
+        n_threads = std::stoul(argv[2]);
+        first_slope = 3;
+    }
+    if (argc > first_slope) {
+        vector<string_view> slopes(argv + first_slope, argv + argc);
+        return day_3::solve_slopes(input.data(), slopes, n_threads, std::cout) ? 0 : 1;
+    }
+    if (n_threads > 1) {
+        return day_3::solve_parallel(input.data(), n_threads, std::cout) ? 0 : 1;
+    }
+    return day_3::solve(input.data(), std::cout) ? 0 : 1;
+}
+#endif
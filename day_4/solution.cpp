@@ -1,161 +1,472 @@
 #include <algorithm>
-#include <fstream>
-#include <iostream>
-#include <regex>
+#include <array>
 #include <bitset>
+#include <charconv>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <string_view>
-#include <ios>
-#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/solver.h"
+#include "../common/stream.h"
+#include "../common/thread_pool.h"
 
 using std::bitset;
-using std::noskipws;
-using std::ifstream;
-using std::invalid_argument;
-using std::out_of_range;
-using std::smatch;
-using std::sregex_iterator;
-using std::stringstream;
-using std::stoi;
+using std::optional;
 using std::string;
+using std::string_view;
+using std::vector;
+
+namespace day_4 {
 
 enum class FieldType : size_t {
     BYR, IYR, EYR, HGT, HCL, ECL, PID, CID
 };
 
-FieldType from_string(const string &s) {
-    if (s == "byr") {
-        return FieldType::BYR;
-    } else if (s == "iyr") {
-        return FieldType::IYR;
-    } else if (s == "eyr") {
-        return FieldType::EYR;
-    } else if (s == "hgt") {
-        return FieldType::HGT;
-    } else if (s == "hcl") {
-        return FieldType::HCL;
-    } else if (s == "ecl") {
-        return FieldType::ECL;
-    } else if (s == "pid") {
-        return FieldType::PID;
-    } else if (s == "cid") {
-        return FieldType::CID;
-    }
-    throw invalid_argument{"unknown FieldType " + s};
+// Key of each FieldType, in order.
+constexpr std::array<string_view, 8> FIELD_KEYS = {
+    "byr", "iyr", "eyr", "hgt", "hcl", "ecl", "pid", "cid"
+};
+
+// Returns the slot of a three-letter key in KEY_TABLE. Bytes are taken as
+// unsigned so keys outside ASCII still hash into the table.
+constexpr size_t key_hash(string_view key)
+{
+    auto byte = [&](size_t i) { return static_cast<size_t>(static_cast<unsigned char>(key[i])); };
+    return (5 * (byte(0) + byte(1)) + byte(2)) % 16;
+}
+
+// Returns the table from key_hash() of each key to its FieldType + 1, with 0
+// for empty slots.
+constexpr std::array<unsigned char, 16> make_key_table()
+{
+    std::array<unsigned char, 16> table{};
+    for (size_t i = 0; i < FIELD_KEYS.size(); i++) {
+        auto& slot = table[key_hash(FIELD_KEYS[i])];
+        if (slot != 0) {
+            throw std::invalid_argument{"key_hash is not perfect"};
+        }
+        slot = i + 1;
+    }
+    return table;
 }
 
-// Returns true when all fields are set that are required for a valid passport.
-bool valid_passport(bitset<8> fields)
+// Perfect hash table of the field keys, checked free of collisions by the
+// compiler.
+constexpr auto KEY_TABLE = make_key_table();
+
+// Returns the FieldType whose key is s, if there is one.
+constexpr optional<FieldType> field_type(string_view s)
 {
-    return (
-        fields.all() ||
-        (fields.count() == 7 && !fields[static_cast<size_t>(FieldType::CID)])
-    );
+    if (s.size() != 3) {
+        return std::nullopt;
+    }
+    auto slot = KEY_TABLE[key_hash(s)];
+    if (slot == 0 || FIELD_KEYS[slot - 1] != s) {
+        return std::nullopt;
+    }
+    return static_cast<FieldType>(slot - 1);
 }
 
-// Returns true if the integer year given in s is in [lower, upper].
-bool valid_year(const string &s, int lower, int upper)
+// Returns the integer at the start of s, read like std::stoi with an optional
+// sign, and removes it from s. Returns nothing if s does not start with an
+// integer or it does not fit in an int.
+optional<int> consume_int_prefix(string_view& s)
 {
-    try {
-        int year = stoi(s);
-        return lower <= year && year <= upper;
-    } catch (invalid_argument) {
-        return false;
+    bool negative = !s.empty() && s.front() == '-';
+    auto rest = s.substr(!s.empty() && (s.front() == '-' || s.front() == '+'));
+    long long magnitude = 0;
+    auto result = std::from_chars(rest.data(), rest.data() + rest.size(), magnitude);
+    if (result.ec != std::errc{} || rest.empty() || rest.front() == '-') {
+        return std::nullopt;
+    }
+    auto value = negative ? -magnitude : magnitude;
+    if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max()) {
+        return std::nullopt;
     }
+    s.remove_prefix(result.ptr - s.data());
+    return static_cast<int>(value);
 }
 
-// Returns true if the value in s is valid for the given FieldType.
-bool valid_value(FieldType ft, const string &s)
+// A passport is the value of each field in its record, the last one given if
+// a field is repeated.
+struct Passport {
+    bitset<8> present;
+    std::array<string_view, 8> values;
+};
+
+// Returns all passports in input.
+//
+// A single pass over the input: whitespace separates "key:value" fields and a
+// blank line starts the next passport. Fields with unknown keys are ignored.
+vector<Passport> parse_input(string_view input)
 {
-    switch (ft) {
-    case FieldType::BYR:
-        return valid_year(s, 1920, 2002);
-    case FieldType::IYR:
-        return valid_year(s, 2010, 2020);
-    case FieldType::EYR:
-        return valid_year(s, 2020, 2030);
-    case FieldType::HGT:
-        try {
-            int height;
-            string measure;
-            stringstream ss{s};
-            ss >> noskipws >> height >> measure ;
-            return (
-                ss &&
-                (
-                    (measure == "cm" && 150 <= height && height <= 193) ||
-                    (measure == "in" && 59 <= height && height <= 76)
-                )
-            );
-        } catch (invalid_argument) {
-            return false;
-        } catch (out_of_range) {
-            return false;
+    vector<Passport> passports(1);
+
+    bool line_start = true;
+    size_t i = 0;
+    while (i < input.size()) {
+        char c = input[i];
+        if (c == '\n') {
+            if (line_start) {
+                passports.emplace_back();
+            }
+            line_start = true;
+            i++;
+            continue;
         }
-    case FieldType::HCL:
-        {
-            auto pred = [](char c) {
-                return ('0' <= c && c <= '9') || ('a' <= c && c <= 'f');
-            };
-            return (
-                s.size() == 7 &&
-                s[0] == '#' &&
-                all_of(s.begin() + 1, s.end(), pred)
-            );
+        line_start = false;
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f') {
+            i++;
+            continue;
+        }
+
+        auto end = std::min(input.find_first_of(" \t\r\v\f\n", i), input.size());
+        auto field = input.substr(i, end - i);
+        i = end;
+
+        auto type = field.size() > 4 && field[3] == ':' ? field_type(field.substr(0, 3)) : std::nullopt;
+        if (type) {
+            auto index = static_cast<size_t>(*type);
+            passports.back().present.set(index);
+            passports.back().values[index] = field.substr(4);
         }
-    case FieldType::ECL:
-        return (
-            s == "amb" || s == "blu" || s == "brn" || s == "gry" ||
-            s == "grn" || s == "hzl" || s == "oth"
-        );
-    case FieldType::PID:
-        return s.size() == 9 && all_of(s.begin(), s.end(), isdigit);
-    case FieldType::CID:
-        return true;
     }
-    throw invalid_argument{"unknown FieldType"};
+
+    return passports;
 }
 
-int main()
-{
-    ifstream data{"input.txt"};
+// Ranges and values accepted by the validators of PassportColumns, by default
+// those of the puzzle.
+struct Rules {
+    std::pair<int, int> byr{1920, 2002};
+    std::pair<int, int> iyr{2010, 2020};
+    std::pair<int, int> eyr{2020, 2030};
+    std::pair<int, int> height_cm{150, 193};
+    std::pair<int, int> height_in{59, 76};
+    vector<string> eye_colours{"amb", "blu", "brn", "gry", "grn", "hzl", "oth"};
+
+    // Longest eye colour accepted, PassportColumns keeps only this many
+    // characters of a value.
+    static constexpr size_t MAX_EYE_COLOUR_SIZE = 15;
+};
+
+// Passports stored by field rather than by record, so each rule is checked in
+// one pass over a single column and changing a rule re-checks just its column.
+//
+// Every field has a fixed-width column with an entry per record, parsed once
+// from the text: years and heights as integers, HCL, ECL and PID as their
+// first 15 characters and length. Each record has a bitmap of the fields it
+// has and one of the fields whose value passed its validator, and a record is
+// valid if the bitwise AND of the two holds every required field.
+class PassportColumns {
+public:
+    explicit PassportColumns(const vector<Passport>& passports)
+        : present(passports.size()),
+          valid(passports.size()),
+          heights(passports.size())
+    {
+        for (auto& column : years) {
+            column.resize(passports.size());
+        }
+        for (auto& column : texts) {
+            column.resize(passports.size());
+        }
+        for (size_t r = 0; r < passports.size(); r++) {
+            const auto& passport = passports[r];
+            present[r] = static_cast<unsigned char>(passport.present.to_ulong());
+            for (auto ft : {FieldType::BYR, FieldType::IYR, FieldType::EYR}) {
+                auto s = passport.values[index(ft)];
+                years[index(ft)][r] = consume_int_prefix(s).value_or(NO_NUMBER);
+            }
+
+            auto hgt = passport.values[index(FieldType::HGT)];
+            auto height = consume_int_prefix(hgt);
+            heights[r].value = height.value_or(NO_NUMBER);
+            heights[r].unit = !height ? Unit::NONE
+                : hgt == "cm" ? Unit::CM
+                : hgt == "in" ? Unit::IN
+                : Unit::NONE;
+
+            for (auto ft : {FieldType::HCL, FieldType::ECL, FieldType::PID}) {
+                texts[text_column(ft)][r] = FixedText{passport.values[index(ft)]};
+            }
+        }
+    }
+
+    size_t size() const { return present.size(); }
+
+    // Re-checks every field against rules.
+    void validate(const Rules& rules)
+    {
+        for (size_t i = 0; i < FIELD_KEYS.size(); i++) {
+            validate(static_cast<FieldType>(i), rules);
+        }
+    }
+
+    // Re-checks the values of field against rules, leaving other fields'
+    // results as they were.
+    //
+    // Throws std::invalid_argument if an eye colour in rules is longer than
+    // Rules::MAX_EYE_COLOUR_SIZE.
+    void validate(FieldType field, const Rules& rules)
+    {
+        switch (field) {
+        case FieldType::BYR:
+            return check_years(field, rules.byr);
+        case FieldType::IYR:
+            return check_years(field, rules.iyr);
+        case FieldType::EYR:
+            return check_years(field, rules.eyr);
+        case FieldType::HGT:
+            return check(field, [&](size_t r) {
+                auto height = heights[r];
+                auto in_range = [&](const std::pair<int, int>& range) {
+                    return range.first <= height.value && height.value <= range.second;
+                };
+                return (height.unit == Unit::CM && in_range(rules.height_cm)) |
+                       (height.unit == Unit::IN && in_range(rules.height_in));
+            });
+        case FieldType::HCL:
+            return check(field, [&, &column = texts[text_column(field)]](size_t r) {
+                const auto& hcl = column[r];
+                bool ok = hcl.size == 7 && hcl.chars[0] == '#';
+                for (size_t i = 1; i < 7; i++) {
+                    auto c = hcl.chars[i];
+                    ok &= ('0' <= c && c <= '9') | ('a' <= c && c <= 'f');
+                }
+                return ok;
+            });
+        case FieldType::ECL:
+            {
+                vector<FixedText> colours;
+                for (const auto& colour : rules.eye_colours) {
+                    if (colour.size() > Rules::MAX_EYE_COLOUR_SIZE) {
+                        throw std::invalid_argument{"eye colour too long: " + colour};
+                    }
+                    colours.emplace_back(colour);
+                }
+                return check(field, [&, &column = texts[text_column(field)]](size_t r) {
+                    const auto& ecl = column[r];
+                    bool ok = false;
+                    for (const auto& colour : colours) {
+                        ok |= ecl == colour;
+                    }
+                    return ok;
+                });
+            }
+        case FieldType::PID:
+            return check(field, [&, &column = texts[text_column(field)]](size_t r) {
+                const auto& pid = column[r];
+                bool ok = pid.size == 9;
+                for (size_t i = 0; i < 9; i++) {
+                    ok &= '0' <= pid.chars[i] && pid.chars[i] <= '9';
+                }
+                return ok;
+            });
+        case FieldType::CID:
+            return check(field, [](size_t /* r */) { return true; });
+        }
+    }
+
+    // Returns the number of records with every required field.
+    int count_present() const
+    {
+        int n = 0;
+        for (auto fields : present) {
+            n += (fields & REQUIRED) == REQUIRED;
+        }
+        return n;
+    }
 
-    bitset<8> fields_p1, fields_p2;
-    int n_valid_p1 = 0, n_valid_p2 = 0;
+    // Returns the number of records with every required field valid under
+    // the rules last passed to validate(), none before it is first called.
+    int count_valid() const
+    {
+        int n = 0;
+        for (size_t r = 0; r < present.size(); r++) {
+            n += (present[r] & valid[r] & REQUIRED) == REQUIRED;
+        }
+        return n;
+    }
 
-    string line;
+private:
+    enum class Unit : unsigned char { NONE, CM, IN };
 
-    std::regex field_regex{
-        "(byr|iyr|eyr|hgt|hcl|ecl|pid|cid):([^[:space:]]+)[[:space:]]*"
+    struct Height {
+        int value;
+        Unit unit;
     };
 
-    while (getline(data, line)) {
-        if (line == "") {
-            n_valid_p1 += valid_passport(fields_p1);
-            fields_p1.reset();
+    // Up to the first 15 characters of a value and its length, capped at 255.
+    struct FixedText {
+        std::array<char, Rules::MAX_EYE_COLOUR_SIZE> chars{};
+        unsigned char size = 0;
 
-            n_valid_p2 += valid_passport(fields_p2);
-            fields_p2.reset();
+        FixedText() = default;
 
-            continue;
+        explicit FixedText(string_view s)
+            : size(static_cast<unsigned char>(std::min<size_t>(s.size(), 255)))
+        {
+            std::copy_n(s.begin(), std::min(s.size(), chars.size()), chars.begin());
         }
-        auto fields_begin = sregex_iterator(line.begin(), line.end(), field_regex);
-        auto fields_end = std::sregex_iterator();
-        for (std::sregex_iterator i = fields_begin; i != fields_end; i++) {
-            smatch match = *i;
-            FieldType ft = from_string(match[1]);
-            auto bit = static_cast<size_t>(ft);
-
-            // Part 1: no validation required.
-            fields_p1.set(bit, true);
-
-            // Part 2: validation required.
-            fields_p2.set(bit, valid_value(ft, match[2]));
+
+        bool operator==(const FixedText& other) const
+        {
+            return size == other.size && chars == other.chars;
+        }
+    };
+
+    // Integer in a column for a value that does not start with one.
+    static constexpr int NO_NUMBER = std::numeric_limits<int>::min();
+
+    // Bits of the fields every valid passport needs, all but CID.
+    static constexpr unsigned char REQUIRED = 0x7f;
+
+    vector<unsigned char> present;   // bit i set if the record has field i
+    vector<unsigned char> valid;     // bit i set if field i passed its check
+    std::array<vector<int>, 3> years;         // BYR, IYR, EYR
+    vector<Height> heights;                   // HGT
+    std::array<vector<FixedText>, 3> texts;   // HCL, ECL, PID
+
+    static size_t index(FieldType ft) { return static_cast<size_t>(ft); }
+
+    static size_t text_column(FieldType ft) { return index(ft) - index(FieldType::HCL); }
+
+    // Sets field's bit of each record's valid bitmap to ok(record).
+    template <typename F>
+    void check(FieldType field, F ok)
+    {
+        const auto bit = static_cast<unsigned char>(1u << index(field));
+        for (size_t r = 0; r < valid.size(); r++) {
+            valid[r] = (valid[r] & ~bit) | (ok(r) ? bit : 0);
         }
     }
-    n_valid_p1 += valid_passport(fields_p1);
-    n_valid_p2 += valid_passport(fields_p2);
 
-    std::cout << n_valid_p1 << " " << n_valid_p2 << std::endl;
+    void check_years(FieldType field, const std::pair<int, int>& range)
+    {
+        check(field, [&, &column = years[index(field)]](size_t r) {
+            auto year = column[r];
+            return range.first <= year && year <= range.second;
+        });
+    }
+};
+
+void benchmark(Bench& bench, const string& filepath)
+{
+    const Input input{filepath};
+    auto columns = bench.phase("parse", [&] {
+        return PassportColumns{parse_input(input.data())};
+    });
+    bench.phase("part_1", [&] { return columns.count_present(); });
+    bench.phase("part_2", [&] {
+        columns.validate(Rules{});
+        return columns.count_valid();
+    });
+}
+
+// Solver holding the passports in columns between phases.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { columns.emplace(parse_input(input)); }
 
+    // Part 1: no validation required.
+    bool part_1(std::ostream& os) override
+    {
+        os << columns->count_present() << " ";
+        return true;
+    }
+
+    // Part 2: validation required.
+    bool part_2(std::ostream& os) override
+    {
+        columns->validate(Rules{});
+        os << columns->count_valid() << std::endl;
+        return true;
+    }
+
+private:
+    optional<PassportColumns> columns;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+// Writes the answers for the input read from fd to os, validated against
+// rules, holding only a chunk of it in memory at a time.
+bool solve_stream(int fd, std::ostream& os, const Rules& rules = Rules{})
+{
+    int n_present = 0;
+    int n_valid = 0;
+    for_each_chunk(fd, "\n\n", [&](string_view chunk) {
+        PassportColumns columns{parse_input(chunk)};
+        columns.validate(rules);
+        n_present += columns.count_present();
+        n_valid += columns.count_valid();
+    });
+    os << n_present << " " << n_valid << std::endl;
+    return true;
+}
+
+// Writes the answers for input to os, validated against rules and counted on
+// n_threads threads.
+//
+// The input is cut at blank lines into a few pieces per thread, so every
+// passport lies in exactly one piece. Each piece is parsed into its own
+// columns and counted, and the counts summed at the end.
+bool solve_parallel(
+    string_view input, size_t n_threads, std::ostream& os, const Rules& rules = Rules{}
+) {
+    ThreadPool pool(n_threads);
+    auto pieces = split_aligned(input, pool.size() * 4, "\n\n");
+    vector<std::pair<int, int>> counts(pieces.size());
+    pool.run(pieces.size(), [&](size_t task, size_t /* worker */) {
+        PassportColumns columns{parse_input(pieces[task])};
+        columns.validate(rules);
+        counts[task] = {columns.count_present(), columns.count_valid()};
+    });
+
+    int n_present = 0;
+    int n_valid = 0;
+    for (const auto& piece_counts : counts) {
+        n_present += piece_counts.first;
+        n_valid += piece_counts.second;
+    }
+    os << n_present << " " << n_valid << std::endl;
+    return true;
+}
+
+} // namespace day_4
+
+#ifndef AOC_NO_MAIN
+// Reads input.txt, or stdin when the only argument is "-". With arguments
+// --threads N, input.txt is split between N threads; build with -pthread.
+int main(int argc, char* argv[])
+{
+    if (argc == 2 && string_view{argv[1]} == "-") {
+        return day_4::solve_stream(0, std::cout) ? 0 : 1;
+    }
+    const Input input{"input.txt"};
+    if (argc == 3 && string_view{argv[1]} == "--threads") {
+        return day_4::solve_parallel(input.data(), std::stoul(argv[2]), std::cout) ? 0 : 1;
+    }
+    return day_4::solve(input.data(), std::cout) ? 0 : 1;
 }
+#endif
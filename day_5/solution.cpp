@@ -1,52 +1,671 @@
 #include <algorithm>
-#include <fstream>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iomanip>
 #include <iostream>
-#include <numeric>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
-using std::ifstream;
-using std::sort;
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/simd.h"
+#include "../common/solver.h"
+#include "../common/stream.h"
+#include "../common/thread_pool.h"
+
 using std::string;
+using std::string_view;
 using std::vector;
 
-int main()
+namespace day_5 {
+
+// Returns the seat ID of a boarding pass.
+//
+// Seat IDs are binary numbers where positions:
+//
+//     [0,  3): encode 0/1 as L/R
+//     [3, 10): encode 0/1 as F/B
+//
+// Parse as a binary number with this encoding.
+constexpr int seat_id(string_view pass)
 {
-    ifstream data{"input.txt"};
-    string line;
-    vector<int> seat_ids;
+    int id = 0;
+    for (char letter : pass) {
+        id = (id * 2) + (letter == 'B' || letter == 'R');
+    }
+    return id;
+}
 
-    // Seat IDs are binary numbers where positions:
-    //
-    //     [0,  3): encode 0/1 as L/R
-    //     [3, 10): encode 0/1 as F/B
+// A cabin layout: a boarding pass is a row code of RowBits F/B letters
+// followed by a column code of ColumnBits L/R letters, read together as the
+// seat ID row * 2^ColumnBits + column.
+template <std::size_t RowBits, std::size_t ColumnBits>
+struct SeatLayout {
+    static constexpr std::size_t ROW_BITS = RowBits;
+    static constexpr std::size_t COLUMN_BITS = ColumnBits;
+
+    // Letters in a boarding pass, and bits in a seat ID.
+    static constexpr std::size_t CODE_SIZE = RowBits + ColumnBits;
+
+    static_assert(RowBits > 0 && ColumnBits > 0 && CODE_SIZE <= 16, "seat IDs are limited to 16 bits");
+};
+
+// The layout of the puzzle: 128 rows of 8 seats.
+using PuzzleLayout = SeatLayout<7, 3>;
+
+// Batch decoders of boarding passes laid out as lines of Letters letters,
+// writing the seat ID of n passes starting at data to ids.
+namespace decode {
+
+// Bytes per boarding pass in the input: the letters and a newline.
+template <std::size_t Letters>
+constexpr std::size_t PASS_SIZE = Letters + 1;
+
+// Bytes a kernel may read from the start of a pass.
+constexpr std::size_t LOAD_SIZE = 16;
+
+using Kernel = void (*)(const char* data, std::size_t n, int* ids);
+
+// One letter at a time.
+template <std::size_t Letters>
+void scalar(const char* data, std::size_t n, int* ids)
+{
+    for (std::size_t i = 0; i < n; i++) {
+        ids[i] = seat_id({data + i * PASS_SIZE<Letters>, Letters});
+    }
+}
+
+#ifdef AOC_SIMD_X86
+// Returns x with the top bit of each byte set if the byte is 'B' or 'R' and
+// all other bits clear.
+inline std::uint64_t one_letters(std::uint64_t x)
+{
+    // the top bit of ~((b & 0x7f) + 0x7f | b) is set only if byte b is zero
+    constexpr std::uint64_t LOW = 0x7f7f7f7f7f7f7f7f;
+    auto zero_bytes = [](std::uint64_t v) { return ~(((v & LOW) + LOW) | v) & ~LOW; };
+    return zero_bytes(x ^ 0x4242424242424242) | zero_bytes(x ^ 0x5252525252525252);
+}
+
+// Returns the ones among the N <= 8 letters at pass in the low N bits, the
+// first letter highest. Bytes are swapped before pext gathers a bit per
+// letter, so the first letter lands in the top bit.
+template <std::size_t N>
+__attribute__((target("bmi2")))
+inline std::uint64_t pext_letters(const char* pass)
+{
+    std::uint64_t letters = 0;
+    std::memcpy(&letters, pass, N);
+    return _pext_u64(one_letters(__builtin_bswap64(letters)), 0x8080808080808080) >> (8 - N);
+}
+
+// Matches the letters of a pass 8 at a time and gathers them with pext.
+template <std::size_t Letters>
+__attribute__((target("bmi2")))
+void pext(const char* data, std::size_t n, int* ids)
+{
+    constexpr std::size_t HEAD = Letters < 8 ? Letters : 8;
+    for (std::size_t i = 0; i < n; i++) {
+        const char* pass = data + i * PASS_SIZE<Letters>;
+        auto id = pext_letters<HEAD>(pass) << (Letters - HEAD) | pext_letters<Letters - HEAD>(pass + HEAD);
+        ids[i] = static_cast<int>(id);
+    }
+}
+
+// Returns the shuffle that reverses the letters of a pass in each 128-bit
+// lane and zeroes the bytes after them.
+template <std::size_t Letters>
+constexpr std::array<char, 32> reverse_letters()
+{
+    std::array<char, 32> indices{};
+    for (std::size_t i = 0; i < 16; i++) {
+        indices[i] = indices[i + 16] = i < Letters ? static_cast<char>(Letters - 1 - i) : -1;
+    }
+    return indices;
+}
+
+// Returns the ones of passes i and i + 1 at data in the low Letters bits of
+// each 16-bit half. A shuffle reverses each pass's letters so the last is bit
+// 0, comparing against 'B' and 'R' marks the ones and movemask gathers them.
+template <std::size_t Letters>
+__attribute__((target("avx2")))
+inline unsigned avx2_pair(const char* data, std::size_t i)
+{
+    static constexpr auto REVERSE = reverse_letters<Letters>();
+    const auto reverse = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(REVERSE.data()));
+    auto first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * PASS_SIZE<Letters>));
+    auto second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + (i + 1) * PASS_SIZE<Letters>));
+    auto letters = _mm256_shuffle_epi8(_mm256_set_m128i(second, first), reverse);
+    auto ones = _mm256_or_si256(
+        _mm256_cmpeq_epi8(letters, _mm256_set1_epi8('B')),
+        _mm256_cmpeq_epi8(letters, _mm256_set1_epi8('R'))
+    );
+    return static_cast<unsigned>(_mm256_movemask_epi8(ones));
+}
+
+// Decodes four passes per iteration, two per 256-bit register. A pass and its
+// newline must fit in a 16-byte lane.
+template <std::size_t Letters>
+__attribute__((target("avx2")))
+void avx2(const char* data, std::size_t n, int* ids)
+{
+    static_assert(Letters < 16, "a pass must fit in a 128-bit lane");
+    constexpr unsigned MASK = (1u << Letters) - 1;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        auto first = avx2_pair<Letters>(data, i);
+        auto second = avx2_pair<Letters>(data, i + 2);
+        ids[i] = first & MASK;
+        ids[i + 1] = first >> 16 & MASK;
+        ids[i + 2] = second & MASK;
+        ids[i + 3] = second >> 16 & MASK;
+    }
+    scalar<Letters>(data + i * PASS_SIZE<Letters>, n - i, ids + i);
+}
+#endif
+
+// Returns the fastest kernel for passes of Letters letters the running CPU
+// supports. pext is only chosen without AVX2, as it is microcoded and slow on
+// older AMD CPUs.
+template <std::size_t Letters>
+Kernel select_kernel()
+{
+#ifdef AOC_SIMD_X86
+    __builtin_cpu_init();
+    if constexpr (Letters < 16) {
+        if (__builtin_cpu_supports("avx2")) {
+            return avx2<Letters>;
+        }
+    }
+    if (__builtin_cpu_supports("bmi2")) {
+        return pext<Letters>;
+    }
+#endif
+    return scalar<Letters>;
+}
+
+} // namespace decode
+
+// Appends the seat ID of each boarding pass in input, coded for Layout, to
+// seat_ids.
+//
+// The leading run of lines of Layout::CODE_SIZE letters is decoded in batches
+// straight from the input, the rest, e.g. a last line without a newline, a
+// line at a time.
+//
+// Blank lines are skipped. Throws std::invalid_argument if a pass does not
+// have Layout::CODE_SIZE letters.
+template <typename Layout = PuzzleLayout>
+void decode_seat_ids(string_view input, vector<int>& seat_ids)
+{
+    constexpr std::size_t LETTERS = Layout::CODE_SIZE;
+    constexpr std::size_t PASS_SIZE = decode::PASS_SIZE<LETTERS>;
+    static const decode::Kernel kernel = decode::select_kernel<LETTERS>();
+
+    std::size_t n = 0;
+    while ((n + 1) * PASS_SIZE <= input.size() && input[n * PASS_SIZE + LETTERS] == '\n') {
+        n++;
+    }
+    // lines shorter than a pass could still put newlines in the right places
+    if (count_char(input.substr(0, n * PASS_SIZE), '\n') != n) {
+        n = 0;
+    }
+    // kernels may read past a pass's newline, but not past the input
+    std::size_t n_batch = 0;
+    if (input.size() >= decode::LOAD_SIZE) {
+        n_batch = std::min(n, (input.size() - decode::LOAD_SIZE) / PASS_SIZE + 1);
+    }
+
+    auto start = seat_ids.size();
+    seat_ids.resize(start + n);
+    kernel(input.data(), n_batch, seat_ids.data() + start);
+    decode::scalar<LETTERS>(
+        input.data() + n_batch * PASS_SIZE, n - n_batch, seat_ids.data() + start + n_batch
+    );
+
+    for (auto line : lines(input.substr(n * PASS_SIZE))) {
+        if (line.empty()) {
+            continue;
+        }
+        if (line.size() != LETTERS) {
+            throw std::invalid_argument{
+                "boarding pass " + string{line} + " has " + std::to_string(line.size())
+                + " letters, expected " + std::to_string(LETTERS)
+            };
+        }
+        seat_ids.push_back(seat_id(line));
+    }
+}
+
+// The set of taken seats of a Layout as one bit per possible seat ID, 128
+// bytes for the puzzle however many boarding passes are added. Queries work
+// a 64-bit word at a time.
+template <typename Layout = PuzzleLayout>
+class SeatMap {
+public:
+    static constexpr int N_SEATS = 1 << Layout::CODE_SIZE;
+
+    // Marks seat id as taken.
     //
-    // Parse as a binary number with this encoding.
-    auto get_seat_id = [](const int seat_id, const char letter) {
-        return (seat_id * 2) + (letter == 'B' || letter == 'R');
-    };
-    while (getline(data, line)) {
-        seat_ids.push_back(accumulate(line.begin(), line.end(), 0, get_seat_id));
+    // Throws std::invalid_argument if id is not a possible seat ID.
+    constexpr void insert(int id)
+    {
+        if (id < 0 || id >= N_SEATS) {
+            throw std::invalid_argument{"invalid seat ID " + std::to_string(id)};
+        }
+        words[id / 64] |= std::uint64_t{1} << id % 64;
+    }
+
+    constexpr bool contains(int id) const
+    {
+        return id >= 0 && id < N_SEATS && (words[id / 64] >> id % 64 & 1);
     }
 
-    sort(seat_ids.begin(), seat_ids.end());
+    // Returns the number of taken seats.
+    constexpr int count() const
+    {
+        int n = 0;
+        for (auto word : words) {
+            n += __builtin_popcountll(word);
+        }
+        return n;
+    }
 
-    // Part 1: Possible without sorting but we need that for Part 2 anyway.
-    auto max_id = *(seat_ids.end() - 1);
-    std::cout << max_id << std::endl;
+    // Returns the lowest taken seat ID, if any seat is taken.
+    constexpr std::optional<int> min() const
+    {
+        for (std::size_t i = 0; i < N_WORDS; i++) {
+            if (words[i] != 0) {
+                return static_cast<int>(i * 64) + __builtin_ctzll(words[i]);
+            }
+        }
+        return std::nullopt;
+    }
 
-    // Part 2: Iterate to find a distance of 2 between any two adjacent values
-    // to indicate a -1/+1 seat ID difference with mine being the missing ID.
-    int my_seat = -1;
-    for (auto i = seat_ids.begin(); i != seat_ids.end() - 1; i++) {
-        if ((*(i + 1) - *i) == 2) {
-            my_seat = *i + 1;
-            break;
+    // Returns the highest taken seat ID, if any seat is taken.
+    constexpr std::optional<int> max() const
+    {
+        for (std::size_t i = N_WORDS; i-- > 0;) {
+            if (words[i] != 0) {
+                return static_cast<int>(i * 64) + 63 - __builtin_clzll(words[i]);
+            }
         }
+        return std::nullopt;
     }
-    if (my_seat == -1) {
-        std::cout << "Own seat not found" << std::endl;
-        return 1;
+
+    // Returns the lowest free seat ID whose neighbours are both taken, if
+    // there is one.
+    constexpr std::optional<int> find_gap() const
+    {
+        for (std::size_t i = 0; i < N_WORDS; i++) {
+            auto word = words[i];
+            // the taken bits shifted onto their upper and lower neighbours,
+            // carrying across words
+            auto below = word << 1 | (i > 0 ? words[i - 1] >> 63 : 0);
+            auto above = word >> 1 | (i + 1 < N_WORDS ? words[i + 1] << 63 : 0);
+            auto gaps = ~word & below & above;
+            if (gaps != 0) {
+                return static_cast<int>(i * 64) + __builtin_ctzll(gaps);
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Calls f(id) for each free seat between the lowest and highest taken
+    // seats, in order.
+    template <typename F>
+    void for_each_missing(F f) const
+    {
+        auto first = min();
+        auto last = max();
+        if (!first) {
+            return;
+        }
+        for (std::size_t i = *first / 64; i <= static_cast<std::size_t>(*last / 64); i++) {
+            auto free = ~words[i];
+            if (i == static_cast<std::size_t>(*first / 64)) {
+                free &= ~std::uint64_t{0} << *first % 64;
+            }
+            if (i == static_cast<std::size_t>(*last / 64)) {
+                free &= ~std::uint64_t{0} >> (63 - *last % 64);
+            }
+            for (; free != 0; free &= free - 1) {
+                f(static_cast<int>(i * 64) + __builtin_ctzll(free));
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t N_WORDS = (N_SEATS + 63) / 64;
+
+    std::array<std::uint64_t, N_WORDS> words{};
+};
+
+// Bytes of input decoded at a time by mark_seats().
+constexpr std::size_t MARK_BATCH_SIZE = 1 << 14;
+
+// Marks the seat of each boarding pass in input as taken in seats, returns the
+// number of passes.
+//
+// The input is decoded in newline-aligned batches, so only a batch's seat IDs
+// are held at a time.
+template <typename Layout>
+std::size_t mark_seats(string_view input, SeatMap<Layout>& seats)
+{
+    std::size_t n_passes = 0;
+    vector<int> seat_ids;
+    while (!input.empty()) {
+        auto cut = input.npos;
+        if (input.size() > MARK_BATCH_SIZE) {
+            cut = input.rfind('\n', MARK_BATCH_SIZE - 1);
+            if (cut == input.npos) {
+                cut = input.find('\n', MARK_BATCH_SIZE);
+            }
+        }
+        auto batch = input.substr(0, cut == input.npos ? input.npos : cut + 1);
+        input.remove_prefix(batch.size());
+
+        seat_ids.clear();
+        decode_seat_ids<Layout>(batch, seat_ids);
+        for (auto id : seat_ids) {
+            seats.insert(id);
+        }
+        n_passes += seat_ids.size();
+    }
+    return n_passes;
+}
+
+// Returns the seats taken by the boarding passes in input.
+SeatMap<> parse_input(string_view input)
+{
+    SeatMap<> seats;
+    mark_seats(input, seats);
+    return seats;
+}
+
+// Part 1: The highest taken seat, found from the top word of the map down.
+std::optional<int> max_seat_id(const SeatMap<>& seats)
+{
+    return seats.max();
+}
+
+// Part 2: A free seat with both neighbours taken, found a word at a time by
+// matching the map against itself shifted by one seat each way.
+std::optional<int> find_my_seat(const SeatMap<>& seats)
+{
+    return seats.find_gap();
+}
+
+namespace compile_time {
+
+// Returns the seats taken by the boarding passes in input.
+constexpr SeatMap<> parse_input(string_view input)
+{
+    SeatMap<> seats;
+    for (auto line : lines(input)) {
+        if (!line.empty()) {
+            seats.insert(seat_id(line));
+        }
+    }
+    return seats;
+}
+
+} // namespace compile_time
+
+#ifdef AOC_EMBED_INPUT
+// The puzzle input compiled into the program, see common/embed.h.
+constexpr string_view EMBEDDED_INPUT =
+#include "input.inc"
+    ;
+
+constexpr auto EMBEDDED_SEATS = compile_time::parse_input(EMBEDDED_INPUT);
+
+constexpr auto EMBEDDED_PART_1 = EMBEDDED_SEATS.max();
+static_assert(EMBEDDED_PART_1, "no boarding passes");
+
+constexpr auto EMBEDDED_PART_2 = EMBEDDED_SEATS.find_gap();
+static_assert(EMBEDDED_PART_2, "own seat not found");
+#endif
+
+void benchmark(Bench& bench, const string& filepath)
+{
+    const Input input{filepath};
+    const auto seats = bench.phase("parse", [&] { return parse_input(input.data()); });
+    bench.phase("part_1", [&] { return max_seat_id(seats); });
+    bench.phase("part_2", [&] { return find_my_seat(seats); });
+}
+
+// Solver holding the map of taken seats between phases.
+class Solution : public Solver {
+public:
+    Solution() = default;
+    explicit Solution(const SeatMap<>& seats) : seats{seats} {}
+
+    void parse(string_view input) override { seats = parse_input(input); }
+
+    bool part_1(std::ostream& os) override
+    {
+        auto max_id = max_seat_id(seats);
+        if (!max_id) {
+            os << "No boarding passes" << std::endl;
+            return false;
+        }
+        os << *max_id << std::endl;
+        return true;
+    }
+
+    bool part_2(std::ostream& os) override
+    {
+        auto my_seat = find_my_seat(seats);
+        if (!my_seat) {
+            os << "Own seat not found" << std::endl;
+            return false;
+        }
+        os << *my_seat << std::endl;
+        return true;
+    }
+
+private:
+    SeatMap<> seats;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os, returns false if one is not found.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+// Writes the answers for the input read from fd to os, returns false if one is
+// not found.
+//
+// Holds only a chunk of the input and the 128-byte seat map in memory at a
+// time.
+bool solve_stream(int fd, std::ostream& os)
+{
+    SeatMap<> seats;
+    for_each_chunk(fd, "\n", [&](string_view chunk) { mark_seats(chunk, seats); });
+
+    Solution solution{seats};
+    return solution.part_1(os) && solution.part_2(os);
+}
+
+// Calls f(SeatLayout<RowBits, ColumnBits>{}) for the layout with the given
+// bits, one of the common layouts compiled in:
+//
+//     5x2   32 rows of  4, regional jets
+//     6x3   64 rows of  8, narrow-bodies
+//     7x3  128 rows of  8, the puzzle
+//     7x4  128 rows of 16, wide-bodies
+//
+// Throws std::invalid_argument for any other layout.
+template <typename F>
+void with_layout(std::size_t row_bits, std::size_t column_bits, F f)
+{
+    if (row_bits == 5 && column_bits == 2) {
+        f(SeatLayout<5, 2>{});
+    } else if (row_bits == 6 && column_bits == 3) {
+        f(SeatLayout<6, 3>{});
+    } else if (row_bits == 7 && column_bits == 3) {
+        f(SeatLayout<7, 3>{});
+    } else if (row_bits == 7 && column_bits == 4) {
+        f(SeatLayout<7, 4>{});
+    } else {
+        throw std::invalid_argument{
+            "unsupported layout " + std::to_string(row_bits) + "x" + std::to_string(column_bits)
+        };
+    }
+}
+
+// The boarding passes of a flight, in a file, and the layout they are coded
+// for.
+struct Flight {
+    string path;
+    std::size_t row_bits = PuzzleLayout::ROW_BITS;
+    std::size_t column_bits = PuzzleLayout::COLUMN_BITS;
+};
+
+// Returns the flight of a "ROWSxCOLUMNS:FILE" spec, e.g. "7x3:input.txt".
+//
+// Throws std::invalid_argument if spec is not of that form.
+Flight parse_flight(string_view spec)
+{
+    auto x = spec.find('x');
+    auto colon = spec.find(':');
+    if (x == spec.npos || colon == spec.npos || x > colon || colon + 1 == spec.size()) {
+        throw std::invalid_argument{"expected ROWSxCOLUMNS:FILE, got " + string{spec}};
+    }
+    Flight flight;
+    flight.path = string{spec.substr(colon + 1)};
+    flight.row_bits = std::stoul(string{spec.substr(0, x)});
+    flight.column_bits = std::stoul(string{spec.substr(x + 1, colon - x - 1)});
+    return flight;
+}
+
+// The seats of a flight once its boarding passes are decoded.
+struct FlightSeats {
+    std::size_t n_passes = 0;
+    int n_taken = 0;
+    vector<int> missing;   // free seat IDs between the lowest and highest taken
+};
+
+// Returns the seats of each flight, whose passes are in inputs, decoded on the
+// threads of pool.
+//
+// Each flight is one task decoding into its own seat map, so threads never
+// share a map.
+vector<FlightSeats> decode_flights(
+    const vector<Flight>& flights, const vector<string_view>& inputs, ThreadPool& pool
+) {
+    vector<FlightSeats> seats(flights.size());
+    pool.run(flights.size(), [&](std::size_t task, std::size_t /* worker */) {
+        const auto& flight = flights[task];
+        with_layout(flight.row_bits, flight.column_bits, [&](auto layout) {
+            SeatMap<decltype(layout)> map;
+            auto& result = seats[task];
+            result.n_passes = mark_seats(inputs[task], map);
+            result.n_taken = map.count();
+            map.for_each_missing([&](int id) { result.missing.push_back(id); });
+        });
+    });
+    return seats;
+}
+
+// Writes a "FILE ROWSxCOLUMNS: P passes, T taken, M missing: ID..." line for
+// each flight to os, and the number of passes decoded per second to log.
+// Returns false if a flight has no boarding passes.
+bool write_flights(
+    const vector<Flight>& flights, std::size_t n_threads, std::ostream& os, std::ostream& log
+) {
+    std::deque<Input> files;
+    vector<string_view> inputs;
+    for (const auto& flight : flights) {
+        inputs.push_back(files.emplace_back(flight.path).data());
+    }
+    ThreadPool pool(n_threads);
+
+    auto start = std::chrono::steady_clock::now();
+    auto seats = decode_flights(flights, inputs, pool);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::size_t n_passes = 0;
+    bool all_boarded = true;
+    for (std::size_t i = 0; i < flights.size(); i++) {
+        const auto& flight = flights[i];
+        n_passes += seats[i].n_passes;
+        all_boarded = all_boarded && seats[i].n_passes > 0;
+        os << flight.path << ' ' << flight.row_bits << 'x' << flight.column_bits << ": "
+           << seats[i].n_passes << " passes, " << seats[i].n_taken << " taken, "
+           << seats[i].missing.size() << " missing:";
+        for (auto id : seats[i].missing) {
+            os << ' ' << id;
+        }
+        os << '\n';
+    }
+    os.flush();
+
+    log << n_passes << " passes of " << flights.size() << " flights in " << std::fixed
+        << std::setprecision(3) << elapsed.count() * 1e3 << " ms on " << pool.size()
+        << " threads: " << std::setprecision(0) << n_passes / elapsed.count() << " passes/s"
+        << std::endl;
+    return all_boarded;
+}
+
+} // namespace day_5
+
+#ifndef AOC_NO_MAIN
+// Usage:
+//
+//     solution                                    # both parts for input.txt
+//     solution -                                  # both parts for stdin
+//     solution --flights [--threads N] SPEC...    # decode_flights()
+//
+// --flights decodes the boarding passes of each flight given as
+// ROWSxCOLUMNS:FILE, see with_layout() for the layouts, on N threads (default:
+// one per hardware thread), and writes each flight's missing seats to stdout
+// and the throughput to stderr. Build with -pthread.
+int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
+{
+#ifdef AOC_EMBED_INPUT
+    // Both answers were found by the compiler.
+    std::cout << *day_5::EMBEDDED_PART_1 << '\n' << *day_5::EMBEDDED_PART_2 << std::endl;
+    return 0;
+#else
+    if (argc == 2 && string_view{argv[1]} == "-") {
+        return day_5::solve_stream(0, std::cout) ? 0 : 1;
+    }
+    if (argc >= 2 && string_view{argv[1]} == "--flights") {
+        try {
+            std::size_t n_threads = std::thread::hardware_concurrency();
+            int first = 2;
+            if (argc >= 4 && string_view{argv[2]} == "--threads") {
+                n_threads = std::stoul(argv[3]);
+                first = 4;
+            }
+            vector<day_5::Flight> flights;
+            for (int i = first; i < argc; i++) {
+                flights.push_back(day_5::parse_flight(argv[i]));
+            }
+            return day_5::write_flights(flights, n_threads, std::cout, std::cerr) ? 0 : 1;
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
     }
-    std::cout << my_seat << std::endl;
+    const Input input{"input.txt"};
+    return day_5::solve(input.data(), std::cout) ? 0 : 1;
+#endif
 }
+#endif
@@ -1,14 +1,31 @@
 #include <bitset>
-#include <fstream>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/solver.h"
+#include "../common/stream.h"
 
 using std::bitset;
-using std::ifstream;
 using std::string;
+using std::string_view;
+using std::vector;
+
+namespace day_6 {
+
+// Answers of a single person where bit i is set if they answered question i.
+using Person = bitset<26>;
+
+// Answers of each person in a group.
+using Group = vector<Person>;
 
-size_t char_id(char x)
+constexpr size_t char_id(char x)
 {
     switch (x) {
     case 'a': return  0;
@@ -41,60 +58,201 @@ size_t char_id(char x)
     throw std::invalid_argument{"unknown char"};
 }
 
-int main()
+// Returns the answers of all groups in input.
+vector<Group> parse_input(string_view input)
 {
-    ifstream data{"input.txt"};
-    string line;
-
-    // Use a bitset to store current state of answers for a group.
-    //
-    // For Part 1, group_p1[i] is set if _any_ person in the group answers
-    // question i.  All bits in group_p1 start out false and are set to true as
-    // each person's answers are read and recorded.
-    //
-    // For Part 2, group_p2[i] is set if _all_ people in the group answer
-    // question i. All bits in group_p2 start out true and group_p2[i] is set
-    // to false if the current person does not answer question i.
-    //
-    // group_p1.count() will return the number of questions to which anyone
-    // answered yes.
-    //
-    // group_p2.count() will return the number of questions to which everyone
-    // has answered yes.
-    bitset<26> group_p1, group_p2;
-    group_p2.set();
-
-    bitset<26> person;         // bitset to read current person's answers into
+    vector<Group> groups;
     bool proc_group = false;   // true if a group is currently being processed
 
-    int sum_counts_p1 = 0;     // sum of all counts for p1
-    int sum_counts_p2 = 0;     // sum of all counts for p1
-
-    while (getline(data, line)) {
+    for (auto line : lines(input)) {
         if (line == "") {
-            // Blank line: add current group count and reset for new group.
-            if (proc_group) {
-                sum_counts_p1 += group_p1.count();
-                group_p1.reset();
+            // Blank line: next person starts a new group.
+            proc_group = false;
+            continue;
+        }
+        if (!proc_group) {
+            groups.emplace_back();
+        }
+        proc_group = true;
+        Person person;
+        for (char c : line) {
+            person.set(char_id(c));
+        }
+        groups.back().push_back(person);
+    }
 
-                sum_counts_p2 += group_p2.count();
-                group_p2.set();
+    return groups;
+}
+
+// Returns the sum over all groups of the number of questions to which anyone
+// (Part 1) or everyone (Part 2) answered yes.
+//
+// Use a bitset to store current state of answers for a group.
+//
+// For Part 1, group_p1[i] is set if _any_ person in the group answers
+// question i.  All bits in group_p1 start out false and are set to true as
+// each person's answers are read and recorded.
+//
+// For Part 2, group_p2[i] is set if _all_ people in the group answer
+// question i. All bits in group_p2 start out true and group_p2[i] is set
+// to false if the current person does not answer question i.
+//
+// group_p1.count() will return the number of questions to which anyone
+// answered yes.
+//
+// group_p2.count() will return the number of questions to which everyone
+// has answered yes.
+int sum_counts(const vector<Group>& groups, bool everyone)
+{
+    int sum = 0;
+    for (const auto& group : groups) {
+        bitset<26> group_p1, group_p2;
+        group_p2.set();
+        for (const auto& person : group) {
+            group_p1 |= person;
+            group_p2 &= person;
+        }
+        sum += everyone ? group_p2.count() : group_p1.count();
+    }
+    return sum;
+}
+
+namespace compile_time {
+
+// Returns the number of bits set in x.
+constexpr int bit_count(std::uint32_t x)
+{
+    int n = 0;
+    for (; x != 0; x &= x - 1) {
+        n++;
+    }
+    return n;
+}
+
+// Returns the sum over all groups in input of the number of questions to
+// which anyone (Part 1) or everyone (Part 2) answered yes.
+//
+// Works like sum_counts() straight off the input, with each person's and
+// group's answers as a 26-bit mask.
+constexpr int sum_counts(string_view input, bool everyone)
+{
+    constexpr std::uint32_t ALL = (1u << 26) - 1;
+
+    int sum = 0;
+    std::uint32_t group_p1 = 0;
+    std::uint32_t group_p2 = ALL;
+    bool proc_group = false;   // true if a group is currently being processed
+
+    for (auto line : lines(input)) {
+        if (line.empty()) {
+            if (proc_group) {
+                sum += bit_count(everyone ? group_p2 : group_p1);
             }
             proc_group = false;
+            group_p1 = 0;
+            group_p2 = ALL;
             continue;
         }
         proc_group = true;
-        person.reset();
+        std::uint32_t person = 0;
         for (char c : line) {
-            person.set(char_id(c));
+            person |= 1u << char_id(c);
         }
         group_p1 |= person;
         group_p2 &= person;
     }
     if (proc_group) {
-        sum_counts_p1 += group_p1.count();
-        sum_counts_p2 += group_p2.count();
+        sum += bit_count(everyone ? group_p2 : group_p1);
     }
+    return sum;
+}
+
+} // namespace compile_time
+
+#ifdef AOC_EMBED_INPUT
+// The puzzle input compiled into the program, see common/embed.h.
+constexpr string_view EMBEDDED_INPUT =
+#include "input.inc"
+    ;
+
+constexpr auto EMBEDDED_PART_1 = compile_time::sum_counts(EMBEDDED_INPUT, false);
+
+constexpr auto EMBEDDED_PART_2 = compile_time::sum_counts(EMBEDDED_INPUT, true);
+#endif
 
-    std::cout << sum_counts_p1 << " " << sum_counts_p2 << std::endl;
+void benchmark(Bench& bench, const string& filepath)
+{
+    const Input input{filepath};
+    const auto groups = bench.phase("parse", [&] { return parse_input(input.data()); });
+    bench.phase("part_1", [&] { return sum_counts(groups, false); });
+    bench.phase("part_2", [&] { return sum_counts(groups, true); });
+}
+
+// Solver holding the parsed groups between phases.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { groups = parse_input(input); }
+
+    bool part_1(std::ostream& os) override
+    {
+        os << sum_counts(groups, false) << " ";
+        return true;
+    }
+
+    bool part_2(std::ostream& os) override
+    {
+        os << sum_counts(groups, true) << std::endl;
+        return true;
+    }
+
+private:
+    vector<Group> groups;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+// Writes the answers for the input read from fd to os, holding only a chunk of
+// it in memory at a time.
+//
+// Chunks end between groups, so each is summed on its own straight off the
+// input like at compile time.
+bool solve_stream(int fd, std::ostream& os)
+{
+    int sum_anyone = 0;
+    int sum_everyone = 0;
+    for_each_chunk(fd, "\n\n", [&](string_view chunk) {
+        sum_anyone += compile_time::sum_counts(chunk, false);
+        sum_everyone += compile_time::sum_counts(chunk, true);
+    });
+    os << sum_anyone << " " << sum_everyone << std::endl;
+    return true;
+}
+
+} // namespace day_6
+
+#ifndef AOC_NO_MAIN
+// Reads input.txt, or stdin when the only argument is "-".
+int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
+{
+#ifdef AOC_EMBED_INPUT
+    // Both answers were found by the compiler.
+    std::cout << day_6::EMBEDDED_PART_1 << " " << day_6::EMBEDDED_PART_2 << std::endl;
+    return 0;
+#else
+    if (argc == 2 && string_view{argv[1]} == "-") {
+        return day_6::solve_stream(0, std::cout) ? 0 : 1;
+    }
+    const Input input{"input.txt"};
+    return day_6::solve(input.data(), std::cout) ? 0 : 1;
+#endif
 }
+#endif
@@ -1,13 +1,23 @@
-#include <fstream>
 #include <iostream>
+#include <memory>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <vector>
 
-using std::istream;
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/solver.h"
+
 using std::ostream;
 using std::set;
+using std::string;
+using std::string_view;
 using std::vector;
 
+namespace day_8 {
+
 // An Instruction in the boot code.
 struct Instruction {
     enum class OpCode {
@@ -18,38 +28,33 @@ struct Instruction {
     int arg;
 };
 
-istream& operator>>(istream& is, Instruction& ins)
+// Returns the Instruction in a line of the form "acc +1".
+Instruction parse_instruction(string_view line)
 {
-    constexpr std::streamsize count = 6;
-    char opcode_str[count];
-
-    if (is.flags() & std::ios_base::skipws) {
-        is >> std::ws;
-    }
-
-    is.get(opcode_str, count);
+    Instruction ins;
 
-    if (opcode_str[3] != ' ' || !(opcode_str[4] == '-' || opcode_str[4] == '+')) {
-        is.clear(std::ios::failbit);
+    if (line.size() < 6 || line[3] != ' ' || !(line[4] == '-' || line[4] == '+')) {
+        throw std::invalid_argument{"invalid instruction: " + string{line}};
     }
 
-    if (opcode_str[0] == 'a' && opcode_str[1] == 'c' && opcode_str[2] == 'c') {
+    auto opcode_str = line.substr(0, 3);
+    if (opcode_str == "acc") {
         ins.opcode = Instruction::OpCode::ACC;
-    } else if (opcode_str[0] == 'j' && opcode_str[1] == 'm' && opcode_str[2] == 'p') {
+    } else if (opcode_str == "jmp") {
         ins.opcode = Instruction::OpCode::JMP;
-    } else if (opcode_str[0] == 'n' && opcode_str[1] == 'o' && opcode_str[2] == 'p') {
+    } else if (opcode_str == "nop") {
         ins.opcode = Instruction::OpCode::NOP;
     } else {
-        is.clear(std::ios::failbit);
+        throw std::invalid_argument{"invalid opcode: " + string{line}};
     }
 
-    is >> ins.arg;
+    ins.arg = parse_int(line.substr(5));
 
-    if (opcode_str[4] == '-') {
+    if (line[4] == '-') {
         ins.arg *= -1;
     }
 
-    return is;
+    return ins;
 }
 
 ostream& operator<<(ostream& os, Instruction& ins)
@@ -73,8 +78,21 @@ ostream& operator<<(ostream& os, Instruction& ins)
     return os;
 }
 
+// Returns the boot code in input.
+vector<Instruction> parse_input(string_view input)
+{
+    vector<Instruction> instructions;
+    for (auto line : lines(input)) {
+        if (line.empty()) {
+            continue;
+        }
+        instructions.push_back(parse_instruction(line));
+    }
+    return instructions;
+}
+
 // Part 1: Returns accumulator up to point of first repeated instruction.
-int accum_until_repeat(vector<Instruction>& instructions)
+int accum_until_repeat(const vector<Instruction>& instructions)
 {
     set<int> executed;
     int pc = 0;
@@ -214,16 +232,52 @@ int accum_loop_fix(const vector<Instruction>& instructions)
     return accum;
 }
 
-int main()
+void benchmark(Bench& bench, const string& filepath)
 {
-    std::ifstream data{"input.txt"};
-    Instruction ins;
-    vector<Instruction> instructions;
+    const Input input{filepath};
+    const auto instructions = bench.phase("parse", [&] { return parse_input(input.data()); });
+    bench.phase("part_1", [&] { return accum_until_repeat(instructions); });
+    bench.phase("part_2", [&] { return accum_loop_fix(instructions); });
+}
 
-    while (data >> ins) {
-        instructions.push_back(ins);
+// Solver holding the parsed program between phases.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { instructions = parse_input(input); }
+
+    bool part_1(std::ostream& os) override
+    {
+        os << accum_until_repeat(instructions) << std::endl;
+        return true;
+    }
+
+    bool part_2(std::ostream& os) override
+    {
+        os << accum_loop_fix(instructions) << std::endl;
+        return true;
     }
 
-    std::cout << accum_until_repeat(instructions) << std::endl;
-    std::cout << accum_loop_fix(instructions) << std::endl;
+private:
+    vector<Instruction> instructions;
+};
+
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+} // namespace day_8
+
+#ifndef AOC_NO_MAIN
+int main()
+{
+    const Input input{"input.txt"};
+    return day_8::solve(input.data(), std::cout) ? 0 : 1;
 }
+#endif
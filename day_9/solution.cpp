@@ -1,32 +1,37 @@
 #include <algorithm>
-#include <fstream>
 #include <iostream>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
-using std::ifstream;
+#include "../common/bench.h"
+#include "../common/input.h"
+#include "../common/solver.h"
+
 using std::string;
+using std::string_view;
 using std::unordered_multiset;
 using std::vector;
 
-// Returns a vector containing each integer on each line in file.
-vector<int> read_data(string file)
-{
-    ifstream data{file};
+namespace day_9 {
+
+using Value = long long;
 
-    vector<int> values;
-    int value;
-    while (data >> value) {
-        values.push_back(value);
+// Returns a vector containing each integer on each line in input.
+vector<Value> read_data(string_view input)
+{
+    vector<Value> values;
+    for (auto token : tokens(input)) {
+        values.push_back(parse_int<Value>(token));
     }
     return values;
 }
 
 // Returns true if target is the sum of two values in window_set.
-bool is_sum(const unordered_multiset<int>& window_set, int target) {
-    unordered_multiset<int> tmp_set{window_set};
+bool is_sum(const unordered_multiset<Value>& window_set, Value target) {
     for (auto value : window_set) {
         auto other = target - value;
         auto n_other = window_set.count(other);
@@ -41,10 +46,10 @@ bool is_sum(const unordered_multiset<int>& window_set, int target) {
 }
 
 // Returns the first value that is not the sum of any two of the previous window_size.
-std::optional<int> first_sum_of_two(const vector<int>& values, const int window_size)
+std::optional<Value> first_sum_of_two(const vector<Value>& values, const int window_size)
 {
-    vector<int>::size_type start = 0, end = 0;
-    unordered_multiset<int> window;
+    vector<Value>::size_type start = 0, end = 0;
+    unordered_multiset<Value> window;
 
     // fill window
     for (int i = 0; i < window_size; i++) {
@@ -64,10 +69,10 @@ std::optional<int> first_sum_of_two(const vector<int>& values, const int window_
 }
 
 // Returns the min and max of the contiguous array of values that sums to target.
-std::pair<int, int> min_max_sum_to(const vector<int>& values, const int target)
+std::pair<Value, Value> min_max_sum_to(const vector<Value>& values, const Value target)
 {
-    vector<int>::size_type start = 0, end = 0;
-    int total = 0;
+    vector<Value>::size_type start = 0, end = 0;
+    Value total = 0;
     while (true) {
         if (total == target) {
             break;
@@ -83,18 +88,62 @@ std::pair<int, int> min_max_sum_to(const vector<int>& values, const int target)
     return {min, max};
 }
 
-int main()
+void benchmark(Bench& bench, const string& filepath)
 {
-    vector<int> values = read_data("input.txt");
+    const Input input{filepath};
+    const auto values = bench.phase("parse", [&] { return read_data(input.data()); });
+    const auto first_sum = bench.phase("part_1", [&] {
+        return first_sum_of_two(values, 25);
+    });
+    bench.phase("part_2", [&] { return min_max_sum_to(values, *first_sum); });
+}
+
+// Solver holding the values, and the part 1 answer that part 2 needs.
+class Solution : public Solver {
+public:
+    void parse(string_view input) override { values = read_data(input); }
+
+    bool part_1(std::ostream& os) override
+    {
+        first_sum = first_sum_of_two(values, 25);
+        if (!first_sum) {
+            os << "Part 1 failed" << std::endl;
+            return false;
+        }
+        os << *first_sum << std::endl;
+        return true;
+    }
 
-    std::optional<int> first_sum = first_sum_of_two(values, 25);
-    if (!first_sum) {
-        std::cout << "Part 1 failed" << std::endl;
-        return 1;
+    // Requires a successful part_1().
+    bool part_2(std::ostream& os) override
+    {
+        auto min_max = min_max_sum_to(values, *first_sum);
+        os << std::get<0>(min_max) + std::get<1>(min_max) << std::endl;
+        return true;
     }
-    std::cout << *first_sum << std::endl;
 
-    auto min_max = min_max_sum_to(values, *first_sum);
+private:
+    vector<Value> values;
+    std::optional<Value> first_sum;
+};
 
-    std::cout << std::get<0>(min_max) + std::get<1>(min_max) << std::endl;
+std::unique_ptr<Solver> make_solver()
+{
+    return std::make_unique<Solution>();
+}
+
+// Writes the answers for input to os, returns false if one is not found.
+bool solve(string_view input, std::ostream& os)
+{
+    return Solution{}.solve(input, os);
+}
+
+} // namespace day_9
+
+#ifndef AOC_NO_MAIN
+int main()
+{
+    const Input input{"input.txt"};
+    return day_9::solve(input.data(), std::cout) ? 0 : 1;
 }
+#endif
@@ -0,0 +1,1251 @@
+// Input generator: writes a valid synthetic puzzle input of any size.
+//
+// Build from the repository root:
+//
+//     g++ -std=c++17 -O2 -o gen/gen gen/gen.cpp
+//
+// Usage:
+//
+//     gen/gen day_N [--size N] [--seed S] > input.txt
+//
+// The meaning of N depends on the day (lines, records, grid side, ...) and is
+// documented on each generator below; it defaults to roughly the size of a
+// real puzzle input. The output depends only on the day, N and S (default: 1)
+// so generated inputs, and benchmarks run on them, are reproducible across
+// machines.
+//
+// Day 23 is not supported as its input is compiled into the solution.
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../common/rng.h"
+
+using std::ostream;
+using std::string;
+using std::vector;
+
+// Returns a string of n characters each drawn uniformly from alphabet.
+string random_string(Rng& rng, size_t n, const string& alphabet)
+{
+    string s(n, ' ');
+    for (auto& c : s) {
+        c = alphabet[rng.uniform(0, alphabet.size() - 1)];
+    }
+    return s;
+}
+
+// Returns n distinct integers drawn uniformly from [lower, upper].
+vector<long long> distinct(Rng& rng, size_t n, long long lower, long long upper)
+{
+    vector<long long> values;
+    std::unordered_set<long long> seen;
+    while (values.size() < n) {
+        auto v = rng.uniform(lower, upper);
+        if (seen.insert(v).second) {
+            values.push_back(v);
+        }
+    }
+    return values;
+}
+
+const string LOWER = "abcdefghijklmnopqrstuvwxyz";
+
+namespace day_1 {
+
+constexpr int TARGET = 2020;
+
+// Returns true if values are distinct and exactly one pair and one triple
+// of them sum to TARGET.
+bool one_pair_one_triple(vector<long long> values)
+{
+    std::sort(values.begin(), values.end());
+    if (std::adjacent_find(values.begin(), values.end()) != values.end()) {
+        return false;
+    }
+
+    int n_pairs = 0;
+    int n_triples = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        for (size_t j = i + 1; j < values.size(); j++) {
+            n_pairs += values[i] + values[j] == TARGET;
+            for (size_t k = j + 1; k < values.size(); k++) {
+                n_triples += values[i] + values[j] + values[k] == TARGET;
+            }
+        }
+    }
+    return n_pairs == 1 && n_triples == 1;
+}
+
+// size: number of expense entries.
+//
+// Exactly one pair and one triple are planted below TARGET. All other entries
+// are above TARGET so they cannot take part in a sum, but are still visited
+// by the searches.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    vector<long long> values;
+    do {
+        auto a = rng.uniform(1, TARGET - 1);
+        auto b = rng.uniform(1, TARGET - 2);
+        auto c = rng.uniform(1, TARGET - 1 - b);
+        values = {a, TARGET - a, b, c, TARGET - b - c};
+    } while (!one_pair_one_triple(values));
+
+    while (static_cast<long long>(values.size()) < size) {
+        values.push_back(rng.uniform(TARGET + 1, 999'999));
+    }
+    rng.shuffle(values);
+
+    for (auto v : values) {
+        os << v << '\n';
+    }
+}
+
+} // namespace day_1
+
+namespace day_2 {
+
+// size: number of password entries.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    for (long long i = 0; i < size; i++) {
+        auto lower = rng.uniform(1, 10);
+        auto upper = rng.uniform(lower + 1, lower + 10);
+        char c = LOWER[rng.uniform(0, 25)];
+
+        // bias towards c so that both policies are satisfied some of the time
+        string password = random_string(rng, rng.uniform(upper, upper + 8), LOWER);
+        for (auto& p : password) {
+            if (rng.chance(0.4)) {
+                p = c;
+            }
+        }
+
+        os << lower << '-' << upper << ' ' << c << ": " << password << '\n';
+    }
+}
+
+} // namespace day_2
+
+namespace day_3 {
+
+constexpr int WIDTH = 31;
+
+// size: number of rows in the map.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    for (long long i = 0; i < size; i++) {
+        for (int j = 0; j < WIDTH; j++) {
+            os << (rng.chance(0.25) ? '#' : '.');
+        }
+        os << '\n';
+    }
+}
+
+} // namespace day_3
+
+namespace day_4 {
+
+const vector<string> EYE_COLOURS = {"amb", "blu", "brn", "gry", "grn", "hzl", "oth"};
+
+// Returns a year in [lower, upper] if valid is set and within 20 years
+// outside it if not.
+string year(Rng& rng, long long lower, long long upper, bool valid)
+{
+    if (valid) {
+        return std::to_string(rng.uniform(lower, upper));
+    }
+    return std::to_string(rng.chance(0.5)
+        ? rng.uniform(lower - 20, lower - 1)
+        : rng.uniform(upper + 1, upper + 20));
+}
+
+// Returns a value for field, which follows the part 2 rules if valid is set.
+string field_value(Rng& rng, const string& field, bool valid)
+{
+    if (field == "byr") {
+        return year(rng, 1920, 2002, valid);
+    } else if (field == "iyr") {
+        return year(rng, 2010, 2020, valid);
+    } else if (field == "eyr") {
+        return year(rng, 2020, 2030, valid);
+    } else if (field == "hgt") {
+        bool cm = rng.chance(0.6);
+        if (valid) {
+            return cm
+                ? std::to_string(rng.uniform(150, 193)) + "cm"
+                : std::to_string(rng.uniform(59, 76)) + "in";
+        } else if (rng.chance(0.5)) {
+            return std::to_string(rng.uniform(59, 193));
+        }
+        return cm
+            ? std::to_string(rng.uniform(194, 210)) + "cm"
+            : std::to_string(rng.uniform(40, 58)) + "in";
+    } else if (field == "hcl") {
+        if (valid) {
+            return "#" + random_string(rng, 6, "0123456789abcdef");
+        }
+        return random_string(rng, rng.uniform(5, 7), "0123456789abcdefxyz");
+    } else if (field == "ecl") {
+        if (valid) {
+            return rng.pick(EYE_COLOURS);
+        }
+        return random_string(rng, 3, "xyz");
+    } else if (field == "pid") {
+        return random_string(rng, valid ? 9 : rng.uniform(0, 1) * 2 + 8, "0123456789");
+    }
+    return std::to_string(rng.uniform(100, 350));
+}
+
+// size: number of passports.
+//
+// Each passport is missing each field (cid more often) some of the time.
+// Most passports have only valid values while the rest hold some invalid
+// ones, and fields are split over a random number of lines.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    vector<string> fields = {"byr", "iyr", "eyr", "hgt", "hcl", "ecl", "pid", "cid"};
+
+    for (long long i = 0; i < size; i++) {
+        if (i > 0) {
+            os << '\n';
+        }
+        rng.shuffle(fields);
+        bool all_valid = rng.chance(0.6);
+        bool first = true;
+        for (const auto& field : fields) {
+            if (!rng.chance(field == "cid" ? 0.6 : 0.95)) {
+                continue;
+            }
+            if (!first) {
+                os << (rng.chance(0.3) ? '\n' : ' ');
+            }
+            os << field << ':' << field_value(rng, field, all_valid || rng.chance(0.7));
+            first = false;
+        }
+        if (first) {
+            os << "cid:" << field_value(rng, "cid", true);
+        }
+        os << '\n';
+    }
+}
+
+} // namespace day_4
+
+namespace day_5 {
+
+constexpr int N_SEATS = 1024;
+
+// size: number of boarding passes, at most N_SEATS - 2.
+//
+// Passes fill a contiguous range of seat IDs except for one missing seat.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    long long n = std::clamp<long long>(size, 2, N_SEATS - 2);
+
+    auto lower = rng.uniform(0, N_SEATS - 1 - n);
+    auto missing = rng.uniform(lower + 1, lower + n - 1);
+    vector<long long> ids;
+    for (auto id = lower; id <= lower + n; id++) {
+        if (id != missing) {
+            ids.push_back(id);
+        }
+    }
+    rng.shuffle(ids);
+
+    for (auto id : ids) {
+        for (int bit = 9; bit >= 0; bit--) {
+            bool set = (id >> bit) & 1;
+            os << (bit >= 3 ? (set ? 'B' : 'F') : (set ? 'R' : 'L'));
+        }
+        os << '\n';
+    }
+}
+
+} // namespace day_5
+
+namespace day_6 {
+
+// size: number of groups.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    for (long long i = 0; i < size; i++) {
+        if (i > 0) {
+            os << '\n';
+        }
+        // questions the whole group tends to answer yes to
+        vector<bool> common(26);
+        for (auto&& c : common) {
+            c = rng.chance(0.3);
+        }
+
+        auto n_people = rng.uniform(1, 5);
+        for (long long j = 0; j < n_people; j++) {
+            string answers;
+            for (int q = 0; q < 26; q++) {
+                if (rng.chance(common[q] ? 0.9 : 0.2)) {
+                    answers.push_back(LOWER[q]);
+                }
+            }
+            if (answers.empty()) {
+                answers.push_back(LOWER[rng.uniform(0, 25)]);
+            }
+            vector<char> shuffled{answers.begin(), answers.end()};
+            rng.shuffle(shuffled);
+            os << string{shuffled.begin(), shuffled.end()} << '\n';
+        }
+    }
+}
+
+} // namespace day_6
+
+namespace day_8 {
+
+// size: number of instructions, at least 30.
+//
+// The program is made of blocks of acc and nop instructions that each end in
+// a jmp. Laid out in memory the blocks form three regions:
+//
+//     loop: executed from pc 0, the last block's jmp has been corrupted to a
+//           nop that falls through to an earlier block
+//     dead: a cycle of blocks that is never executed
+//     exit: a chain of blocks ending with a jmp past the last instruction
+//
+// Every jmp fallthrough and nop target in the loop region stays within the
+// loop or dead regions, so restoring the corrupted jmp is the only single
+// change that terminates the program.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    long long n = std::max<long long>(size, 30);
+
+    vector<long long> start;
+    vector<long long> length;
+    for (long long pos = 0; pos < n; pos += length.back()) {
+        start.push_back(pos);
+        length.push_back(std::min(rng.uniform(1, 6), n - pos));
+    }
+    auto n_blocks = static_cast<long long>(start.size());
+    auto n_loop = std::max<long long>(3, n_blocks * 2 / 5);
+    auto n_dead = std::max<long long>(1, n_blocks / 5);
+    auto dead_end = start[n_loop + n_dead];   // first instruction of exit region
+
+    // execution order of the loop blocks: begins at pc 0 and the corrupted
+    // block must not be the last loop block in memory, so its fallthrough
+    // stays in the loop
+    vector<long long> loop_order;
+    for (long long b = 1; b < n_loop; b++) {
+        loop_order.push_back(b);
+    }
+    rng.shuffle(loop_order);
+    if (loop_order.back() == n_loop - 1) {
+        std::swap(loop_order.front(), loop_order.back());
+    }
+    loop_order.insert(loop_order.begin(), 0);
+
+    vector<long long> dead_order;
+    for (long long b = n_loop; b < n_loop + n_dead; b++) {
+        dead_order.push_back(b);
+    }
+    rng.shuffle(dead_order);
+
+    vector<long long> exit_order;
+    for (long long b = n_loop + n_dead; b < n_blocks; b++) {
+        exit_order.push_back(b);
+    }
+    rng.shuffle(exit_order);
+
+    // jmp target of each block
+    vector<long long> target(n_blocks);
+    for (size_t i = 0; i + 1 < loop_order.size(); i++) {
+        target[loop_order[i]] = start[loop_order[i + 1]];
+    }
+    target[loop_order.back()] = start[exit_order.front()];
+    for (size_t i = 0; i < dead_order.size(); i++) {
+        target[dead_order[i]] = start[dead_order[(i + 1) % dead_order.size()]];
+    }
+    for (size_t i = 0; i + 1 < exit_order.size(); i++) {
+        target[exit_order[i]] = start[exit_order[i + 1]];
+    }
+    target[exit_order.back()] = n;
+
+    auto write = [&os](const char* opcode, long long arg) {
+        os << opcode << ' ' << (arg >= 0 ? "+" : "") << arg << '\n';
+    };
+
+    for (long long b = 0; b < n_blocks; b++) {
+        bool in_loop = b < n_loop;
+        auto end = start[b] + length[b] - 1;
+        for (auto pc = start[b]; pc < end; pc++) {
+            if (rng.chance(0.6)) {
+                write("acc", rng.uniform(-50, 50));
+            } else {
+                auto to = rng.uniform(0, in_loop ? dead_end - 1 : n - 1);
+                write("nop", to - pc);
+            }
+        }
+        write(b == loop_order.back() ? "nop" : "jmp", target[b] - end);
+    }
+}
+
+} // namespace day_8
+
+namespace day_9 {
+
+constexpr int PREAMBLE = 25;
+constexpr long long LIMIT = 1LL << 52;
+
+// size: number of values.
+//
+// Every value up to the invalid one must be the sum of two of the previous
+// PREAMBLE, which at least doubles the smallest value every PREAMBLE values.
+// Sums of the smallest values are chosen to grow as slowly as possible, but
+// only around 1,100 valid values fit below LIMIT; the invalid value is
+// placed there and the rest of the file is filler the solution never reads.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    long long n = std::max<long long>(size, PREAMBLE + 2);
+
+    vector<long long> values = distinct(rng, PREAMBLE, 1, 2 * PREAMBLE);
+    while (static_cast<long long>(values.size()) < n - 1) {
+        vector<long long> window{values.end() - PREAMBLE, values.end()};
+        std::sort(window.begin(), window.end());
+
+        // as in the puzzle, values in a window are distinct, so take one of
+        // the smallest sums not already in the window
+        vector<long long> sums;
+        for (int i = 0; i < PREAMBLE; i++) {
+            for (int j = i + 1; j < PREAMBLE; j++) {
+                auto sum = window[i] + window[j];
+                if (!std::binary_search(window.begin(), window.end(), sum)) {
+                    sums.push_back(sum);
+                }
+            }
+        }
+        std::sort(sums.begin(), sums.end());
+        sums.erase(std::unique(sums.begin(), sums.end()), sums.end());
+        auto value = sums[rng.uniform(0, std::min<long long>(sums.size(), 4) - 1)];
+        if (value > LIMIT) {
+            break;
+        }
+        values.push_back(value);
+    }
+
+    // the invalid value is the sum of a contiguous range that is not the sum
+    // of two values in the window before it
+    auto p = static_cast<long long>(values.size());
+    std::unordered_set<long long> window{values.end() - PREAMBLE, values.end()};
+    long long invalid;
+    bool is_sum;
+    do {
+        auto first = rng.uniform(p / 2, p - 3);
+        auto last = std::min(p - 1, first + rng.uniform(1, 16));
+        invalid = 0;
+        for (auto k = first; k <= last; k++) {
+            invalid += values[k];
+        }
+        is_sum = false;
+        for (auto v : window) {
+            is_sum = is_sum || (v != invalid - v && window.count(invalid - v));
+        }
+    } while (is_sum);
+    values.push_back(invalid);
+
+    while (static_cast<long long>(values.size()) < n) {
+        values.push_back(rng.uniform(1, LIMIT));
+    }
+
+    for (auto v : values) {
+        os << v << '\n';
+    }
+}
+
+} // namespace day_9
+
+namespace day_10 {
+
+// size: number of adapters.
+//
+// Adjacent ratings differ by 1 in runs of up to four, separated by 3s.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    vector<long long> adapters;
+    long long jolts = 0;
+    while (static_cast<long long>(adapters.size()) < size) {
+        auto run = rng.uniform(0, 4);
+        for (long long i = 0; i < run && static_cast<long long>(adapters.size()) < size; i++) {
+            adapters.push_back(++jolts);
+        }
+        if (static_cast<long long>(adapters.size()) < size) {
+            jolts += 3;
+            adapters.push_back(jolts);
+        }
+    }
+    rng.shuffle(adapters);
+
+    for (auto a : adapters) {
+        os << a << '\n';
+    }
+}
+
+} // namespace day_10
+
+namespace day_11 {
+
+using Layout = vector<string>;
+
+// Returns the seats in layout as indices i * size + j, and for each seat the
+// positions in that list of the seats it sees: the nearest seat in each
+// direction if far is set and only adjacent ones if not.
+std::pair<vector<long long>, vector<vector<long long>>> visible(const Layout& layout, bool far)
+{
+    long long n = layout.size();
+    vector<long long> seat_of(n * n, -1);
+    vector<long long> seats;
+    for (long long i = 0; i < n; i++) {
+        for (long long j = 0; j < n; j++) {
+            if (layout[i][j] != '.') {
+                seat_of[i * n + j] = seats.size();
+                seats.push_back(i * n + j);
+            }
+        }
+    }
+
+    vector<vector<long long>> seen(seats.size());
+    for (size_t s = 0; s < seats.size(); s++) {
+        for (long long di = -1; di <= 1; di++) {
+            for (long long dj = -1; dj <= 1; dj++) {
+                auto x = seats[s] / n + di;
+                auto y = seats[s] % n + dj;
+                while ((di != 0 || dj != 0) && 0 <= x && x < n && 0 <= y && y < n) {
+                    if (seat_of[x * n + y] != -1) {
+                        seen[s].push_back(seat_of[x * n + y]);
+                        break;
+                    }
+                    if (!far) {
+                        break;
+                    }
+                    x += di;
+                    y += dj;
+                }
+            }
+        }
+    }
+    return {seats, seen};
+}
+
+// Returns the seats, as indices i * size + j, that keep changing once seating
+// starts to repeat itself, or none if layout settles.
+//
+// Seating either settles or alternates between two states, so comparing with
+// the state two rounds ago detects every layout that never settles.
+vector<long long> unsettled(const Layout& layout, bool far, int min_occupied)
+{
+    auto [seats, seen] = visible(layout, far);
+    vector<char> occupied(seats.size()), before, next;
+    auto max_rounds = 100 * static_cast<long long>(layout.size()) + 1'000;
+
+    for (long long round = 0; ; round++) {
+        next = occupied;
+        for (size_t s = 0; s < seats.size(); s++) {
+            int n_occupied = 0;
+            for (auto t : seen[s]) {
+                n_occupied += occupied[t];
+            }
+            if (!occupied[s] && n_occupied == 0) {
+                next[s] = true;
+            } else if (occupied[s] && n_occupied >= min_occupied) {
+                next[s] = false;
+            }
+        }
+        if (next == occupied) {
+            return {};
+        }
+        if (next == before || round == max_rounds) {
+            vector<long long> changing;
+            for (size_t s = 0; s < seats.size(); s++) {
+                if (next[s] != occupied[s]) {
+                    changing.push_back(seats[s]);
+                }
+            }
+            return changing;
+        }
+        before = std::move(occupied);
+        occupied = std::move(next);
+    }
+}
+
+// size: number of rows and columns in the seat layout.
+//
+// Random layouts often end up oscillating forever rather than settling, so a
+// few of the oscillating seats under either set of rules are replaced by floor
+// at a time until both settle.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    Layout layout(size, string(size, '.'));
+    for (auto& row : layout) {
+        for (auto& c : row) {
+            c = rng.chance(0.85) ? 'L' : '.';
+        }
+    }
+
+    bool settled = false;
+    while (!settled) {
+        settled = true;
+        for (auto [far, min_occupied] : {std::pair{false, 4}, std::pair{true, 5}}) {
+            auto changing = unsettled(layout, far, min_occupied);
+            if (changing.empty()) {
+                continue;
+            }
+            rng.shuffle(changing);
+            changing.resize(std::max<size_t>(1, changing.size() / 16));
+            for (auto seat : changing) {
+                layout[seat / size][seat % size] = '.';
+            }
+            settled = false;
+            break;
+        }
+    }
+
+    for (const auto& row : layout) {
+        os << row << '\n';
+    }
+}
+
+} // namespace day_11
+
+namespace day_12 {
+
+constexpr long long WAYPOINT_LIMIT = 1'000;
+constexpr long long POSITION_LIMIT = 1'000'000'000;
+
+// A position or direction as (east, north).
+struct Vec {
+    long long east;
+    long long north;
+};
+
+// Returns v rotated clockwise by degrees, a multiple of 90.
+Vec rotate(Vec v, long long degrees)
+{
+    for (auto i = ((degrees / 90) % 4 + 4) % 4; i > 0; i--) {
+        v = {v.north, -v.east};
+    }
+    return v;
+}
+
+// size: number of navigation instructions.
+//
+// Both ships are simulated while generating so that waypoint moves and F
+// moves which would take any coordinate out of range of the solution's int
+// are replaced, keeping every answer representable.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    Vec ship{0, 0};
+    Vec heading{1, 0};
+    Vec waypoint_ship{0, 0};
+    Vec waypoint{10, 1};
+
+    auto out_of_range = [](const Vec& v, long long limit) {
+        return std::abs(v.east) > limit || std::abs(v.north) > limit;
+    };
+
+    for (long long i = 0; i < size; i++) {
+        auto kind = rng.uniform(0, 99);
+        if (kind < 15) {
+            auto degrees = 90 * rng.uniform(1, 3);
+            bool right = rng.chance(0.5);
+            heading = rotate(heading, right ? degrees : -degrees);
+            waypoint = rotate(waypoint, right ? degrees : -degrees);
+            os << (right ? 'R' : 'L') << degrees << '\n';
+            continue;
+        }
+
+        auto value = rng.uniform(1, 99);
+        if (kind < 55) {
+            Vec next_ship{
+                ship.east + value * heading.east,
+                ship.north + value * heading.north,
+            };
+            Vec next_waypoint_ship{
+                waypoint_ship.east + value * waypoint.east,
+                waypoint_ship.north + value * waypoint.north,
+            };
+            if (
+                !out_of_range(next_ship, POSITION_LIMIT) &&
+                !out_of_range(next_waypoint_ship, POSITION_LIMIT)
+            ) {
+                ship = next_ship;
+                waypoint_ship = next_waypoint_ship;
+                os << 'F' << value << '\n';
+                continue;
+            }
+        }
+
+        // moves in opposite directions are adjacent
+        static const std::array<std::pair<char, Vec>, 4> moves{{
+            {'N', {0, 1}}, {'S', {0, -1}}, {'E', {1, 0}}, {'W', {-1, 0}},
+        }};
+        auto move = rng.uniform(0, 3);
+        auto moved = [&](const Vec& v) {
+            const auto& dir = moves[move].second;
+            return Vec{v.east + value * dir.east, v.north + value * dir.north};
+        };
+        if (out_of_range(moved(waypoint), WAYPOINT_LIMIT)) {
+            // move back towards the ship instead
+            move ^= 1;
+        }
+        ship = moved(ship);
+        waypoint = moved(waypoint);
+        os << moves[move].first << value << '\n';
+    }
+}
+
+} // namespace day_12
+
+namespace day_14 {
+
+constexpr int VALUE_SIZE = 36;
+constexpr int MAX_FLOATING = 9;
+
+// size: number of instructions.
+//
+// Masks have at most MAX_FLOATING floating bits so each version 2 write
+// touches at most 2^MAX_FLOATING addresses.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    long long i = 0;
+    while (i < size) {
+        string mask = random_string(rng, VALUE_SIZE, "01");
+        vector<long long> positions;
+        for (long long p = 0; p < VALUE_SIZE; p++) {
+            positions.push_back(p);
+        }
+        rng.shuffle(positions);
+        for (long long k = rng.uniform(0, MAX_FLOATING); k > 0; k--) {
+            mask[positions[k - 1]] = 'X';
+        }
+        os << "mask = " << mask << '\n';
+        i++;
+
+        for (auto n_writes = rng.uniform(1, 6); n_writes > 0 && i < size; n_writes--, i++) {
+            os << "mem[" << rng.uniform(0, 65'535) << "] = "
+               << rng.uniform(0, 1'000'000'000) << '\n';
+        }
+    }
+}
+
+} // namespace day_14
+
+namespace day_15 {
+
+constexpr int MAX_STARTING = 2019;
+
+// size: number of distinct starting numbers, at most MAX_STARTING so that
+// they are all spoken before the part 1 turn.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    long long n = std::clamp<long long>(size, 1, MAX_STARTING);
+    auto numbers = distinct(rng, n, 0, 4 * n + 16);
+    for (long long i = 0; i < n; i++) {
+        os << (i > 0 ? "," : "") << numbers[i];
+    }
+    os << '\n';
+}
+
+} // namespace day_15
+
+namespace day_17 {
+
+// size: number of rows and columns in the initial slice.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    for (long long i = 0; i < size; i++) {
+        for (long long j = 0; j < size; j++) {
+            os << (rng.chance(0.5) ? '#' : '.');
+        }
+        os << '\n';
+    }
+}
+
+} // namespace day_17
+
+namespace day_18 {
+
+constexpr double MAX_RESULT = 1e12;
+
+// An expression and its value under the part 1 and part 2 precedence rules.
+struct Expression {
+    string text;
+    double part_1;
+    double part_2;
+};
+
+// Returns a random expression with up to depth levels of nested parentheses.
+Expression expression(Rng& rng, int depth)
+{
+    auto operand = [&]() -> Expression {
+        if (depth > 0 && rng.chance(0.25)) {
+            auto e = expression(rng, depth - 1);
+            return {"(" + e.text + ")", e.part_1, e.part_2};
+        }
+        double digit = rng.uniform(1, 9);
+        return {std::to_string(static_cast<int>(digit)), digit, digit};
+    };
+
+    auto first = operand();
+    Expression result = first;
+    double product = 1;       // part 2: product of completed sums
+    double sum = first.part_2;
+    for (auto n = rng.uniform(1, 5); n > 0; n--) {
+        bool add = rng.chance(0.5);
+        auto e = operand();
+        result.text += (add ? " + " : " * ") + e.text;
+        result.part_1 = add ? result.part_1 + e.part_1 : result.part_1 * e.part_1;
+        if (add) {
+            sum += e.part_2;
+        } else {
+            product *= sum;
+            sum = e.part_2;
+        }
+    }
+    result.part_2 = product * sum;
+    return result;
+}
+
+// size: number of expressions.
+//
+// Expressions whose value under either set of rules exceeds MAX_RESULT are
+// redrawn, so the sum over size expressions fits in a long long.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    for (long long i = 0; i < size; i++) {
+        Expression e;
+        do {
+            e = expression(rng, 2);
+        } while (e.part_1 > MAX_RESULT || e.part_2 > MAX_RESULT);
+        os << e.text << '\n';
+    }
+}
+
+} // namespace day_18
+
+namespace day_20 {
+
+const vector<string> MONSTER = {
+    "                  # ",
+    "#    ##    ##    ###",
+    " #  #  #  #  #  #   ",
+};
+
+using Grid = vector<string>;
+
+// Returns grid rotated clockwise.
+Grid rotate(const Grid& grid)
+{
+    Grid rotated(grid[0].size(), string(grid.size(), '.'));
+    for (size_t i = 0; i < grid.size(); i++) {
+        for (size_t j = 0; j < grid[i].size(); j++) {
+            rotated[j][grid.size() - 1 - i] = grid[i][j];
+        }
+    }
+    return rotated;
+}
+
+// size: number of tiles, rounded down to a square.
+//
+// An image containing sea monsters is drawn first and then cut into
+// overlapping tiles whose shared borders are chosen so that each border
+// matches exactly one other. Tiles grow beyond 10 pixels when there are too
+// many borders for 10 pixels to keep them unique.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    long long side = 1;
+    while ((side + 1) * (side + 1) <= size) {
+        side++;
+    }
+    long long n_borders = 2 * side * (side + 1);
+    long long tile_size = 10;
+    while ((1LL << (tile_size - 1)) < n_borders + n_borders / 2) {
+        tile_size++;
+    }
+    long long step = tile_size - 1;
+    long long image_size = side * (tile_size - 2);
+    long long grid_size = side * step + 1;
+
+    // the image, with monsters planted at random positions that do not
+    // overlap earlier ones
+    Grid image(image_size, string(image_size, '.'));
+    for (auto& row : image) {
+        for (auto& c : row) {
+            c = rng.chance(0.35) ? '#' : '.';
+        }
+    }
+    long long monster_rows = MONSTER.size();
+    long long monster_cols = MONSTER[0].size();
+    if (image_size >= monster_cols) {
+        vector<vector<bool>> used(image_size, vector<bool>(image_size));
+        for (auto n = image_size * image_size / 200; n > 0; n--) {
+            auto i = rng.uniform(0, image_size - monster_rows);
+            auto j = rng.uniform(0, image_size - monster_cols);
+            bool free = true;
+            for (long long x = 0; x < monster_rows; x++) {
+                for (long long y = 0; y < monster_cols; y++) {
+                    free = free && !(MONSTER[x][y] == '#' && used[i + x][j + y]);
+                }
+            }
+            if (!free) {
+                continue;
+            }
+            for (long long x = 0; x < monster_rows; x++) {
+                for (long long y = 0; y < monster_cols; y++) {
+                    if (MONSTER[x][y] == '#') {
+                        image[i + x][j + y] = '#';
+                        used[i + x][j + y] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // the full picture, where rows and columns that are a multiple of step
+    // are tile borders shared by neighbouring tiles
+    Grid grid(grid_size, string(grid_size, '.'));
+    for (long long i = 0; i < grid_size; i++) {
+        for (long long j = 0; j < grid_size; j++) {
+            if (i % step != 0 && j % step != 0) {
+                auto ii = i / step * (tile_size - 2) + i % step - 1;
+                auto jj = j / step * (tile_size - 2) + j % step - 1;
+                grid[i][j] = image[ii][jj];
+            } else if (i % step == 0 && j % step == 0) {
+                grid[i][j] = rng.chance(0.5) ? '#' : '.';
+            }
+        }
+    }
+
+    // draw each border until it is not a palindrome and neither it nor its
+    // reverse has been used before
+    std::unordered_set<string> used;
+    auto draw_border = [&](auto get) {
+        while (true) {
+            string border;
+            for (long long k = 0; k < tile_size; k++) {
+                auto& c = get(k);
+                if (k != 0 && k != step) {
+                    c = rng.chance(0.5) ? '#' : '.';
+                }
+                border.push_back(c);
+            }
+            string reversed{border.rbegin(), border.rend()};
+            if (border != reversed && !used.count(border) && !used.count(reversed)) {
+                used.insert(border);
+                return;
+            }
+        }
+    };
+    for (long long t = 0; t <= side; t++) {
+        for (long long u = 0; u < side; u++) {
+            draw_border([&](long long k) -> char& { return grid[t * step][u * step + k]; });
+            draw_border([&](long long k) -> char& { return grid[u * step + k][t * step]; });
+        }
+    }
+
+    // cut, orient and shuffle the tiles
+    vector<long long> ids = size <= 9'000
+        ? distinct(rng, side * side, 1'000, 9'999)
+        : distinct(rng, side * side, 1'000, 1'000 + 2 * side * side);
+    vector<Grid> tiles;
+    for (long long ti = 0; ti < side; ti++) {
+        for (long long tj = 0; tj < side; tj++) {
+            Grid tile;
+            for (long long i = 0; i < tile_size; i++) {
+                tile.push_back(grid[ti * step + i].substr(tj * step, tile_size));
+            }
+            for (auto r = rng.uniform(0, 3); r > 0; r--) {
+                tile = rotate(tile);
+            }
+            if (rng.chance(0.5)) {
+                for (auto& row : tile) {
+                    std::reverse(row.begin(), row.end());
+                }
+            }
+            tiles.push_back(tile);
+        }
+    }
+    rng.shuffle(tiles);
+
+    for (size_t t = 0; t < tiles.size(); t++) {
+        os << (t > 0 ? "\n" : "") << "Tile " << ids[t] << ":\n";
+        for (const auto& row : tiles[t]) {
+            os << row << '\n';
+        }
+    }
+}
+
+} // namespace day_20
+
+namespace day_21 {
+
+const vector<string> ALLERGENS = {
+    "dairy", "eggs", "fish", "nuts", "peanuts", "sesame", "shellfish", "soy", "wheat",
+};
+
+// size: number of foods.
+//
+// Each allergen is in one ingredient. Foods listing an allergen always
+// contain its ingredient and extra foods are added where needed so that the
+// ingredient is the only one common to every food listing the allergen.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    long long n_ingredients = std::max<long long>(50, 5 * size);
+    long long n_allergens = ALLERGENS.size();
+
+    vector<string> ingredients;
+    std::unordered_set<string> seen;
+    while (static_cast<long long>(ingredients.size()) < n_ingredients) {
+        auto name = random_string(rng, rng.uniform(3, 8), LOWER);
+        if (seen.insert(name).second) {
+            ingredients.push_back(name);
+        }
+    }
+    // ingredient i contains allergen i for i < n_allergens
+
+    // ingredients shared by every food listing each allergen so far
+    vector<vector<bool>> common(n_allergens);
+
+    auto food = [&](vector<long long> listed, vector<bool> in_food) {
+        for (auto a : listed) {
+            in_food[a] = true;
+            if (common[a].empty()) {
+                common[a] = in_food;
+            } else {
+                for (long long i = 0; i < n_ingredients; i++) {
+                    common[a][i] = common[a][i] && in_food[i];
+                }
+            }
+        }
+        vector<long long> contents;
+        for (long long i = 0; i < n_ingredients; i++) {
+            if (in_food[i]) {
+                contents.push_back(i);
+            }
+        }
+        rng.shuffle(contents);
+        for (auto i : contents) {
+            os << ingredients[i] << ' ';
+        }
+        std::sort(listed.begin(), listed.end());
+        os << "(contains ";
+        for (size_t k = 0; k < listed.size(); k++) {
+            os << (k > 0 ? ", " : "") << ALLERGENS[listed[k]];
+        }
+        os << ")\n";
+    };
+
+    for (long long f = 0; f < size; f++) {
+        vector<bool> in_food(n_ingredients);
+        for (long long k = rng.uniform(10, 40); k > 0; k--) {
+            in_food[rng.uniform(0, n_ingredients - 1)] = true;
+        }
+        vector<long long> listed = distinct(rng, rng.uniform(1, 3), 0, n_allergens - 1);
+        food(listed, in_food);
+    }
+
+    for (long long a = 0; a < n_allergens; a++) {
+        auto n_common = common[a].empty()
+            ? n_ingredients
+            : std::count(common[a].begin(), common[a].end(), true);
+        if (n_common > 1) {
+            vector<bool> in_food(n_ingredients);
+            for (long long k = rng.uniform(10, 40); k > 0; k--) {
+                auto i = rng.uniform(0, n_ingredients - 1);
+                if (!common[a].empty() && !common[a][i]) {
+                    in_food[i] = true;
+                }
+            }
+            food({a}, in_food);
+        }
+    }
+}
+
+} // namespace day_21
+
+namespace day_22 {
+
+// Returns true if a game of (non-recursive) Combat ends within max_rounds.
+bool combat_ends(std::deque<long long> p1, std::deque<long long> p2, long long max_rounds)
+{
+    for (long long round = 0; round < max_rounds; round++) {
+        if (p1.empty() || p2.empty()) {
+            return true;
+        }
+        auto c1 = p1.front();
+        auto c2 = p2.front();
+        p1.pop_front();
+        p2.pop_front();
+        if (c1 > c2) {
+            p1.push_back(c1);
+            p1.push_back(c2);
+        } else {
+            p2.push_back(c2);
+            p2.push_back(c1);
+        }
+    }
+    return false;
+}
+
+// size: total number of cards, rounded up to be even.
+//
+// Deals that would make a game of Combat run forever are redealt.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    long long n = std::max<long long>(2, size + size % 2);
+    vector<long long> cards;
+    for (long long c = 1; c <= n; c++) {
+        cards.push_back(c);
+    }
+
+    std::deque<long long> p1, p2;
+    do {
+        rng.shuffle(cards);
+        p1.assign(cards.begin(), cards.begin() + n / 2);
+        p2.assign(cards.begin() + n / 2, cards.end());
+    } while (!combat_ends(p1, p2, 100 * n * n));
+
+    os << "Player 1:\n";
+    for (auto c : p1) {
+        os << c << '\n';
+    }
+    os << "\nPlayer 2:\n";
+    for (auto c : p2) {
+        os << c << '\n';
+    }
+}
+
+} // namespace day_22
+
+namespace day_24 {
+
+// size: number of tiles to flip.
+void generate(Rng& rng, long long size, ostream& os)
+{
+    const vector<string> directions = {"e", "se", "sw", "w", "nw", "ne"};
+    for (long long i = 0; i < size; i++) {
+        for (auto n = rng.uniform(10, 25); n > 0; n--) {
+            os << rng.pick(directions);
+        }
+        os << '\n';
+    }
+}
+
+} // namespace day_24
+
+namespace day_25 {
+
+constexpr long long MOD = 20201227;
+constexpr long long SUBJECT = 7;
+
+// Returns SUBJECT transformed loop_size times.
+long long public_key(long long loop_size)
+{
+    long long key = 1;
+    for (long long i = 0; i < loop_size; i++) {
+        key = key * SUBJECT % MOD;
+    }
+    return key;
+}
+
+// size: largest loop size, at most MOD - 1. The solution's running time is
+// proportional to the loop sizes, each drawn from [size / 2, size].
+void generate(Rng& rng, long long size, ostream& os)
+{
+    long long n = std::clamp<long long>(size, 2, MOD - 1);
+    os << public_key(rng.uniform(n / 2, n)) << '\n';
+    os << public_key(rng.uniform(n / 2, n)) << '\n';
+}
+
+} // namespace day_25
+
+using Generator = void (*)(Rng&, long long, ostream&);
+
+// Generator and default size of each day.
+struct Day {
+    string name;
+    Generator generate;
+    long long default_size;
+};
+
+const vector<Day> DAYS = {
+    {"day_1", day_1::generate, 200},
+    {"day_2", day_2::generate, 1'000},
+    {"day_3", day_3::generate, 323},
+    {"day_4", day_4::generate, 290},
+    {"day_5", day_5::generate, 800},
+    {"day_6", day_6::generate, 490},
+    {"day_8", day_8::generate, 630},
+    {"day_9", day_9::generate, 1'000},
+    {"day_10", day_10::generate, 100},
+    {"day_11", day_11::generate, 95},
+    {"day_12", day_12::generate, 780},
+    {"day_14", day_14::generate, 580},
+    {"day_15", day_15::generate, 7},
+    {"day_17", day_17::generate, 8},
+    {"day_18", day_18::generate, 380},
+    {"day_20", day_20::generate, 144},
+    {"day_21", day_21::generate, 40},
+    {"day_22", day_22::generate, 50},
+    {"day_24", day_24::generate, 480},
+    {"day_25", day_25::generate, 10'000'000},
+};
+
+// Returns the Day registered as name or throws if there is none.
+const Day& find_day(const string& name)
+{
+    for (const auto& day : DAYS) {
+        if (day.name == name) {
+            return day;
+        }
+    }
+    throw std::invalid_argument{"unknown day " + name};
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " day_N [--size N] [--seed S]" << std::endl;
+        return 1;
+    }
+
+    try {
+        const auto& day = find_day(argv[1]);
+        long long size = day.default_size;
+        unsigned long long seed = 1;
+        for (int i = 2; i < argc; i++) {
+            string arg = argv[i];
+            if (arg == "--size" && i + 1 < argc) {
+                size = std::atoll(argv[++i]);
+            } else if (arg == "--seed" && i + 1 < argc) {
+                seed = std::strtoull(argv[++i], nullptr, 10);
+            } else {
+                throw std::invalid_argument{"unknown argument " + arg};
+            }
+        }
+        if (size < 1) {
+            throw std::invalid_argument{"--size must be at least 1"};
+        }
+
+        Rng rng{seed};
+        std::ios::sync_with_stdio(false);
+        day.generate(rng, size, std::cout);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}